@@ -62,6 +62,8 @@ public class ImGui : ModuleRules
 				"CoreUObject",
 				"Engine",
 				"InputCore",
+				"RenderCore",
+				"RHI",
 				"Slate",
 				"SlateCore"
 				// ... add private dependencies that you statically link with here ...	
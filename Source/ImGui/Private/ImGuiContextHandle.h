@@ -0,0 +1,14 @@
+// Distributed under the MIT License (MIT) (see accompanying LICENSE file)
+
+#pragma once
+
+#include "Utilities/WorldContextIndex.h"
+
+
+// Handle to a context slot in context manager. It can be cached to quickly access context proxy without any lookup.
+// Slot generation is incremented every time a new context is created in that slot, what invalidates old handles.
+struct FImGuiContextHandle
+{
+	int32 Index = Utilities::INVALID_CONTEXT_INDEX;
+	uint32 Generation = 0;
+};
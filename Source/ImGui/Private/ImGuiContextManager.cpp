@@ -6,6 +6,7 @@
 
 #include "ImGuiDelegatesContainer.h"
 #include "ImGuiImplementation.h"
+#include "ImGuiModuleSettings.h"
 #include "Utilities/ScopeGuards.h"
 #include "Utilities/WorldContext.h"
 #include "Utilities/WorldContextIndex.h"
@@ -59,12 +60,11 @@ namespace
 #endif // WITH_EDITOR
 }
 
-FImGuiContextManager::FImGuiContextManager()
+FImGuiContextManager::FImGuiContextManager(const FImGuiModuleSettings& InSettings)
+	: Settings(InSettings)
+	, FontAtlas(InSettings)
+	, SettingsStorage(InSettings)
 {
-	unsigned char* Pixels;
-	int Width, Height, Bpp;
-	FontAtlas.GetTexDataAsRGBA32(&Pixels, &Width, &Height, &Bpp);
-
 	FWorldDelegates::OnWorldTickStart.AddRaw(this, &FImGuiContextManager::OnWorldTickStart);
 #if ENGINE_COMPATIBILITY_WITH_WORLD_POST_ACTOR_TICK
 	FWorldDelegates::OnWorldPostActorTick.AddRaw(this, &FImGuiContextManager::OnWorldPostActorTick);
@@ -80,24 +80,65 @@ FImGuiContextManager::~FImGuiContextManager()
 #endif
 }
 
+void FImGuiContextManager::ResetGamepadNavigation()
+{
+	for (FContextData& ContextData : Contexts)
+	{
+		if (ContextData.ContextProxy)
+		{
+			ContextData.ContextProxy->GetInputState().ResetGamepadNavigation();
+		}
+	}
+
+	for (auto& Entry : OffscreenContexts)
+	{
+		Entry.Value->GetInputState().ResetGamepadNavigation();
+	}
+}
+
 void FImGuiContextManager::Tick(float DeltaSeconds)
 {
-	// In editor, worlds can get invalid. We could remove corresponding entries, but that would mean resetting ImGui
-	// context every time when PIE session is restarted. Instead we freeze contexts until their worlds are re-created.
+	// In editor, worlds can get invalid. We could remove corresponding entries, but that would mean recreating ImGui
+	// context every time when PIE session is restarted. Instead we freeze contexts until their worlds are re-created
+	// and then we reset and reuse them, what saves allocations and reloading of ini files between sessions. Contexts that
+	// stay frozen for longer time are evicted as defined in settings.
 
-	for (auto& Pair : Contexts)
+	const double Time = FPlatformTime::Seconds();
+
+	for (int32 Index = 0; Index < Contexts.Num(); Index++)
 	{
-		auto& ContextData = Pair.Value;
+		auto& ContextData = Contexts[Index];
+		if (!ContextData.ContextProxy)
+		{
+			continue;
+		}
+
 		if (ContextData.CanTick())
 		{
 			ContextData.ContextProxy->Tick(DeltaSeconds);
+			EnforceMemoryBudget(ContextData, Time);
 		}
-		else
+		else if (!ContextData.bIsFrozen)
 		{
+			ContextData.bIsFrozen = true;
+			ContextData.FrozenTime = Time;
+
 			// Clear to make sure that we don't store objects registered for world that is no longer valid.
-			FImGuiDelegatesContainer::Get().OnWorldDebug(Pair.Key).Clear();
+			FImGuiDelegatesContainer::FWorldDelegates& WorldDelegates = FImGuiDelegatesContainer::Get().GetWorldDelegates(Index);
+			WorldDelegates.Debug.Clear();
+			WorldDelegates.DebugListeners.Clear();
+		}
+		else if (!ContextData.bIsTrimmed && Time - ContextData.FrozenTime >= Settings.GetContextEvictionDelay())
+		{
+			EvictContext(ContextData);
 		}
 	}
+
+	// Swap rebuilt font atlas and rasterise glyphs requested by contexts, so they are ready for the next frame.
+	FontAtlas.Update();
+
+	// Write settings saved by contexts in this or previous frames.
+	SettingsStorage.Update();
 }
 
 #if ENGINE_COMPATIBILITY_LEGACY_WORLD_ACTOR_TICK
@@ -135,14 +176,100 @@ void FImGuiContextManager::OnWorldPostActorTick(UWorld* World, ELevelTick TickTy
 }
 #endif // ENGINE_COMPATIBILITY_WITH_WORLD_POST_ACTOR_TICK
 
+FImGuiContextManager::FContextData& FImGuiContextManager::AddContextData(int32 ContextIndex, FContextData&& Data)
+{
+	if (ContextIndex >= Contexts.Num())
+	{
+		Contexts.SetNum(ContextIndex + 1);
+	}
+
+	FContextData& Slot = Contexts[ContextIndex];
+	const uint32 Generation = Slot.Generation + 1;
+	Slot = MoveTemp(Data);
+	Slot.Generation = Generation;
+	return Slot;
+}
+
+FImGuiContextProxy& FImGuiContextManager::GetOffscreenContextProxy(const FName& ContextName)
+{
+	TUniquePtr<FImGuiContextProxy>& ContextProxy = OffscreenContexts.FindOrAdd(ContextName);
+	if (UNLIKELY(!ContextProxy))
+	{
+		ContextProxy = MakeUnique<FImGuiContextProxy>(TEXT("Offscreen_") + ContextName.ToString(),
+			Utilities::INVALID_CONTEXT_INDEX, nullptr, &FontAtlas, &SettingsStorage);
+
+		// Offscreen delegates are stored in the delegates container, so they can survive hot-reloading. Their addresses
+		// are stable, so we can resolve them once.
+		FSimpleMulticastDelegate* OffscreenDebugEvent = &FImGuiDelegatesContainer::Get().OnOffscreenDebug(ContextName);
+		ContextProxy->OnDraw().AddLambda([OffscreenDebugEvent]()
+		{
+			if (OffscreenDebugEvent->IsBound())
+			{
+				OffscreenDebugEvent->Broadcast();
+			}
+		});
+	}
+
+	return *ContextProxy;
+}
+
+void FImGuiContextManager::EvictContext(FContextData& ContextData)
+{
+	switch (Settings.GetContextEvictionPolicy())
+	{
+	case EImGuiContextEvictionPolicy::Trim:
+	{
+		const SIZE_T ReclaimedSize = ContextData.ContextProxy->TrimMemory();
+		ContextData.bIsTrimmed = true;
+		UE_LOG(LogImGui, Log, TEXT("Trimmed unused ImGui context '%s'. Reclaimed %llu bytes."),
+			*ContextData.ContextProxy->GetName(), static_cast<uint64>(ReclaimedSize));
+		break;
+	}
+	case EImGuiContextEvictionPolicy::Destroy:
+	{
+		// Slot keeps its generation, so handles to the destroyed context become invalid when a new one is created.
+		const SIZE_T ReclaimedSize = ContextData.ContextProxy->GetAllocatedSize();
+		UE_LOG(LogImGui, Log, TEXT("Destroyed unused ImGui context '%s'. Reclaimed at least %llu bytes."),
+			*ContextData.ContextProxy->GetName(), static_cast<uint64>(ReclaimedSize));
+		ContextData.ContextProxy.Reset();
+		ContextData.bIsFrozen = false;
+		break;
+	}
+	default:
+		break;
+	}
+}
+
+void FImGuiContextManager::EnforceMemoryBudget(FContextData& ContextData, double Time)
+{
+	// Trimming releases memory that is re-allocated when windows are used again, so to avoid doing it every frame, we
+	// trim at most once per interval.
+	constexpr double TrimInterval = 1.0;
+
+	const int64 Budget = Settings.GetContextMemoryBudget();
+	if (Budget > 0 && Time - ContextData.BudgetTrimTime >= TrimInterval)
+	{
+		const FImGuiMemoryCounters& Counters = ContextData.ContextProxy->GetMemoryCounters();
+		if (Counters.LiveBytes > Budget)
+		{
+			ContextData.BudgetTrimTime = Time;
+
+			// Context is still in use, so we keep its draw data.
+			const SIZE_T ReclaimedSize = ContextData.ContextProxy->TrimMemory(true);
+			UE_LOG(LogImGui, Verbose, TEXT("ImGui context '%s' exceeded memory budget (%lld/%lld bytes). Reclaimed %llu bytes."),
+				*ContextData.ContextProxy->GetName(), static_cast<int64>(Counters.LiveBytes), Budget, static_cast<uint64>(ReclaimedSize));
+		}
+	}
+}
+
 #if WITH_EDITOR
 FImGuiContextManager::FContextData& FImGuiContextManager::GetEditorContextData()
 {
-	FContextData* Data = Contexts.Find(Utilities::EDITOR_CONTEXT_INDEX);
+	FContextData* Data = FindContextData(Utilities::EDITOR_CONTEXT_INDEX);
 
 	if (UNLIKELY(!Data))
 	{
-		Data = &Contexts.Emplace(Utilities::EDITOR_CONTEXT_INDEX, FContextData{ GetEditorContextName(), Utilities::EDITOR_CONTEXT_INDEX, DrawMultiContextEvent, FontAtlas, -1 });
+		Data = &AddContextData(Utilities::EDITOR_CONTEXT_INDEX, FContextData{ GetEditorContextName(), Utilities::EDITOR_CONTEXT_INDEX, DrawMultiContextEvent, FontAtlas, SettingsStorage, -1 });
 		ContextProxyCreatedEvent.Broadcast(Utilities::EDITOR_CONTEXT_INDEX, *Data->ContextProxy);
 	}
 
@@ -153,11 +280,11 @@ FImGuiContextManager::FContextData& FImGuiContextManager::GetEditorContextData()
 #if !WITH_EDITOR
 FImGuiContextManager::FContextData& FImGuiContextManager::GetStandaloneWorldContextData()
 {
-	FContextData* Data = Contexts.Find(Utilities::STANDALONE_GAME_CONTEXT_INDEX);
+	FContextData* Data = FindContextData(Utilities::STANDALONE_GAME_CONTEXT_INDEX);
 
 	if (UNLIKELY(!Data))
 	{
-		Data = &Contexts.Emplace(Utilities::STANDALONE_GAME_CONTEXT_INDEX, FContextData{ GetWorldContextName(), Utilities::STANDALONE_GAME_CONTEXT_INDEX, DrawMultiContextEvent, FontAtlas });
+		Data = &AddContextData(Utilities::STANDALONE_GAME_CONTEXT_INDEX, FContextData{ GetWorldContextName(), Utilities::STANDALONE_GAME_CONTEXT_INDEX, DrawMultiContextEvent, FontAtlas, SettingsStorage });
 		ContextProxyCreatedEvent.Broadcast(Utilities::STANDALONE_GAME_CONTEXT_INDEX, *Data->ContextProxy);
 	}
 
@@ -194,23 +321,31 @@ FImGuiContextManager::FContextData& FImGuiContextManager::GetWorldContextData(co
 		Index, *World.GetName(), static_cast<int32>(World.WorldType), static_cast<int32>(World.GetNetMode()));
 #endif
 
-	FContextData* Data = Contexts.Find(Index);
+	FContextData* Data = FindContextData(Index);
 
 #if WITH_EDITOR
 	if (UNLIKELY(!Data))
 	{
-		Data = &Contexts.Emplace(Index, FContextData{ GetWorldContextName(World), Index, DrawMultiContextEvent, FontAtlas, WorldContext->PIEInstance });
+		Data = &AddContextData(Index, FContextData{ GetWorldContextName(World), Index, DrawMultiContextEvent, FontAtlas, SettingsStorage, WorldContext->PIEInstance });
 		ContextProxyCreatedEvent.Broadcast(Index, *Data->ContextProxy);
 	}
 	else
 	{
 		// Because we allow (for the sake of continuity) to map different PIE instances to the same index.
 		Data->PIEInstance = WorldContext->PIEInstance;
+
+		// Reuse context frozen after the previous session, but reset its state, so it starts the new session clean.
+		if (Data->bIsFrozen)
+		{
+			Data->bIsFrozen = false;
+			Data->bIsTrimmed = false;
+			Data->ContextProxy->Reset();
+		}
 	}
 #else
 	if (UNLIKELY(!Data))
 	{
-		Data = &Contexts.Emplace(Index, FContextData{ GetWorldContextName(World), Index, DrawMultiContextEvent, FontAtlas });
+		Data = &AddContextData(Index, FContextData{ GetWorldContextName(World), Index, DrawMultiContextEvent, FontAtlas, SettingsStorage });
 		ContextProxyCreatedEvent.Broadcast(Index, *Data->ContextProxy);
 	}
 #endif
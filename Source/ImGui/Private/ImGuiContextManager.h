@@ -2,7 +2,10 @@
 
 #pragma once
 
+#include "ImGuiContextHandle.h"
 #include "ImGuiContextProxy.h"
+#include "ImGuiFontAtlas.h"
+#include "ImGuiSettingsStorage.h"
 
 
 // TODO: It might be useful to broadcast FContextProxyCreatedDelegate to users, to support similar cases to our ImGui
@@ -13,12 +16,14 @@
 // @param ContextProxy - Created context proxy
 DECLARE_MULTICAST_DELEGATE_TwoParams(FContextProxyCreatedDelegate, int32, FImGuiContextProxy&);
 
+class FImGuiModuleSettings;
+
 // Manages ImGui context proxies.
 class FImGuiContextManager
 {
 public:
 
-	FImGuiContextManager();
+	FImGuiContextManager(const FImGuiModuleSettings& InSettings);
 
 	FImGuiContextManager(const FImGuiContextManager&) = delete;
 	FImGuiContextManager& operator=(const FImGuiContextManager&) = delete;
@@ -28,8 +33,9 @@ public:
 
 	~FImGuiContextManager();
 
-	ImFontAtlas& GetFontAtlas() { return FontAtlas; }
-	const ImFontAtlas& GetFontAtlas() const { return FontAtlas; }
+	FImGuiFontAtlas& GetFontAtlas() { return FontAtlas; }
+
+	FImGuiSettingsStorage& GetSettingsStorage() { return SettingsStorage; }
 
 
 #if WITH_EDITOR
@@ -48,11 +54,29 @@ public:
 	// Get or create ImGui context proxy for given world. Additionally get context index for that proxy.
 	FORCEINLINE FImGuiContextProxy& GetWorldContextProxy(const UWorld& World, int32& OutContextIndex) { return *GetWorldContextData(World, &OutContextIndex).ContextProxy; }
 
+	// Get or create offscreen ImGui context proxy with given name. Offscreen contexts are not tied to any world or
+	// viewport and they are not updated by this manager. Instead, they are updated on demand, when they are rendered.
+	FImGuiContextProxy& GetOffscreenContextProxy(const FName& ContextName);
+
 	// Get context proxy by index, or null if context with that index doesn't exist.
 	FORCEINLINE FImGuiContextProxy* GetContextProxy(int32 ContextIndex)
 	{
-		FContextData* Data = Contexts.Find(ContextIndex);
-		return Data ? Data->ContextProxy.Get() : nullptr;
+		return IsInRange(ContextIndex) ? Contexts[ContextIndex].ContextProxy.Get() : nullptr;
+	}
+
+	// Get handle to a context with given index. If context doesn't exist, returned handle is invalid, but it can be
+	// used with the same result as any other invalid handle.
+	FORCEINLINE FImGuiContextHandle GetContextHandle(int32 ContextIndex) const
+	{
+		return IsInRange(ContextIndex) && Contexts[ContextIndex].ContextProxy
+			? FImGuiContextHandle{ ContextIndex, Contexts[ContextIndex].Generation } : FImGuiContextHandle{};
+	}
+
+	// Get context proxy by handle, or null if handle is invalid or context for which it was created no longer exists.
+	FORCEINLINE FImGuiContextProxy* GetContextProxy(const FImGuiContextHandle& Handle)
+	{
+		return IsInRange(Handle.Index) && Contexts[Handle.Index].Generation == Handle.Generation
+			? Contexts[Handle.Index].ContextProxy.Get() : nullptr;
 	}
 
 	// Delegate called for all contexts in manager, right after calling context specific draw event. Allows listeners
@@ -62,15 +86,21 @@ public:
 	// Delegate called when new context proxy is created.
 	FContextProxyCreatedDelegate& OnContextProxyCreated() { return ContextProxyCreatedEvent; }
 
+	// Clear navigation inputs in all contexts, including offscreen ones.
+	void ResetGamepadNavigation();
+
 	void Tick(float DeltaSeconds);
 
 private:
 
 	struct FContextData
 	{
-		FContextData(const FString& ContextName, int32 ContextIndex, FSimpleMulticastDelegate& SharedDrawEvent, ImFontAtlas& FontAtlas, int32 InPIEInstance = -1)
+		FContextData() = default;
+
+		FContextData(const FString& ContextName, int32 ContextIndex, FSimpleMulticastDelegate& SharedDrawEvent, FImGuiFontAtlas& FontAtlas,
+			FImGuiSettingsStorage& SettingsStorage, int32 InPIEInstance = -1)
 			: PIEInstance(InPIEInstance)
-			, ContextProxy(new FImGuiContextProxy(ContextName, ContextIndex, &SharedDrawEvent, &FontAtlas))
+			, ContextProxy(new FImGuiContextProxy(ContextName, ContextIndex, &SharedDrawEvent, &FontAtlas, &SettingsStorage))
 		{
 		}
 
@@ -78,8 +108,41 @@ private:
 
 		int32 PIEInstance = -1;
 		TUniquePtr<FImGuiContextProxy> ContextProxy;
+
+		// Set when world of this context is no longer valid. Frozen context is kept to be reused by the next session.
+		bool bIsFrozen = false;
+
+		// Set when memory of frozen context was trimmed.
+		bool bIsTrimmed = false;
+
+		// Time when context was frozen.
+		double FrozenTime = 0.0;
+
+		// Time when context was trimmed after exceeding memory budget.
+		double BudgetTrimTime = 0.0;
+
+		// Incremented every time a new context is created in this slot.
+		uint32 Generation = 0;
 	};
 
+	// Check whether index is in range allocated for contexts (it doesn't mean that context exists).
+	FORCEINLINE bool IsInRange(int32 ContextIndex) const
+	{
+		return static_cast<uint32>(ContextIndex) < static_cast<uint32>(Contexts.Num());
+	}
+
+	// Get context data at given index, or null if context with that index doesn't exist.
+	FORCEINLINE FContextData* FindContextData(int32 ContextIndex)
+	{
+		return IsInRange(ContextIndex) && Contexts[ContextIndex].ContextProxy ? &Contexts[ContextIndex] : nullptr;
+	}
+
+	FContextData& AddContextData(int32 ContextIndex, FContextData&& Data);
+
+	void EvictContext(FContextData& ContextData);
+
+	void EnforceMemoryBudget(FContextData& ContextData, double Time);
+
 #if ENGINE_COMPATIBILITY_LEGACY_WORLD_ACTOR_TICK
 	void OnWorldTickStart(ELevelTick TickType, float DeltaSeconds);
 #endif
@@ -99,11 +162,19 @@ private:
 
 	FContextData& GetWorldContextData(const UWorld& World, int32* OutContextIndex = nullptr);
 
-	TMap<int32, FContextData> Contexts;
+	const FImGuiModuleSettings& Settings;
+
+	// Declared before contexts, so they outlive them.
+	FImGuiFontAtlas FontAtlas;
+	FImGuiSettingsStorage SettingsStorage;
+
+	// Contexts indexed directly by context index. Indices are small and dense, so slots without context are cheap.
+	TArray<FContextData> Contexts;
+
+	// Offscreen contexts are identified by names and don't have context indices.
+	TMap<FName, TUniquePtr<FImGuiContextProxy>> OffscreenContexts;
 
 	FSimpleMulticastDelegate DrawMultiContextEvent;
 
 	FContextProxyCreatedDelegate ContextProxyCreatedEvent;
-
-	ImFontAtlas FontAtlas;
 };
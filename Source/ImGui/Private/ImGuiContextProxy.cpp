@@ -5,12 +5,16 @@
 #include "ImGuiContextProxy.h"
 
 #include "ImGuiDelegatesContainer.h"
+#include "ImGuiFontAtlas.h"
 #include "ImGuiImplementation.h"
 #include "ImGuiInteroperability.h"
+#include "ImGuiSettingsStorage.h"
 #include "Utilities/Arrays.h"
 
 #include <Runtime/Launch/Resources/Version.h>
 
+#include <imgui_internal.h>
+
 
 static constexpr float DEFAULT_CANVAS_WIDTH = 3840.f;
 static constexpr float DEFAULT_CANVAS_HEIGHT = 2160.f;
@@ -18,37 +22,35 @@ static constexpr float DEFAULT_CANVAS_HEIGHT = 2160.f;
 
 namespace
 {
-	FString GetSaveDirectory()
+	template<typename T>
+	FORCEINLINE SIZE_T GetAllocatedBytes(const ImVector<T>& Vector)
 	{
-#if ENGINE_COMPATIBILITY_LEGACY_SAVED_DIR
-		const FString SavedDir = FPaths::GameSavedDir();
-#else
-		const FString SavedDir = FPaths::ProjectSavedDir();
-#endif
-
-		FString Directory = FPaths::Combine(*SavedDir, TEXT("ImGui"));
-
-		// Make sure that directory is created.
-		IPlatformFile::GetPlatformPhysical().CreateDirectory(*Directory);
-
-		return Directory;
+		return Vector.Capacity * sizeof(T);
 	}
 
-	FString GetIniFile(const FString& Name)
+	SIZE_T GetAllocatedBytes(const ImDrawList& DrawList)
 	{
-		static FString SaveDirectory = GetSaveDirectory();
-		return FPaths::Combine(SaveDirectory, Name + TEXT(".ini"));
+		return GetAllocatedBytes(DrawList.CmdBuffer) + GetAllocatedBytes(DrawList.IdxBuffer)
+			+ GetAllocatedBytes(DrawList.VtxBuffer) + GetAllocatedBytes(DrawList._Path);
 	}
 }
 
-FImGuiContextProxy::FImGuiContextProxy(const FString& InName, int32 InContextIndex, FSimpleMulticastDelegate* InSharedDrawEvent, ImFontAtlas* InFontAtlas)
+FImGuiContextProxy::FImGuiContextProxy(const FString& InName, int32 InContextIndex, FSimpleMulticastDelegate* InSharedDrawEvent, FImGuiFontAtlas* InFontAtlas,
+	FImGuiSettingsStorage* InSettingsStorage)
 	: Name(InName)
+	, MemoryCounters(ImGuiMemoryTracker::GetCounters(InName))
 	, ContextIndex(InContextIndex)
 	, SharedDrawEvent(InSharedDrawEvent)
-	, IniFilename(TCHAR_TO_ANSI(*GetIniFile(InName)))
+	, WorldDelegates((InContextIndex != Utilities::INVALID_CONTEXT_INDEX) ? &FImGuiDelegatesContainer::Get().GetWorldDelegates(InContextIndex) : nullptr)
+	, FontAtlas(InFontAtlas)
+	, FontAtlasInUse(InFontAtlas->GetShared())
+	, SettingsStorage(InSettingsStorage)
 {
+	// Attribute all allocations made by this context to its counters.
+	ImGuiMemoryTracker::FOwnerScope MemoryOwner{ MemoryCounters };
+
 	// Create context.
-	Context = ImGui::CreateContext(InFontAtlas);
+	Context = ImGui::CreateContext(&FontAtlasInUse.Get());
 
 	// Set this context in ImGui for initialization (any allocations will be tracked in this context).
 	SetAsCurrent();
@@ -56,8 +58,10 @@ FImGuiContextProxy::FImGuiContextProxy(const FString& InName, int32 InContextInd
 	// Start initialization.
 	ImGuiIO& IO = ImGui::GetIO();
 
-	// Set session data storage.
-	IO.IniFilename = IniFilename.c_str();
+	// Session data is exchanged with settings storage, which handles file I/O in background. ImGui allows to load
+	// settings only before the first frame.
+	IO.IniFilename = nullptr;
+	SettingsStorage->LoadSettings(Name);
 
 	// Use pre-defined canvas size.
 	IO.DisplaySize = { DEFAULT_CANVAS_WIDTH, DEFAULT_CANVAS_HEIGHT };
@@ -75,11 +79,15 @@ FImGuiContextProxy::~FImGuiContextProxy()
 {
 	if (Context)
 	{
+		ImGuiMemoryTracker::FOwnerScope MemoryOwner{ MemoryCounters };
+
 		// It seems that to properly shutdown context we need to set it as the current one (at least in this framework
 		// version), even though we can pass it to the destroy function.
 		SetAsCurrent();
 
 		// Save context data and destroy.
+		SaveSettings();
+		FImGuiDelegatesContainer::Get().ReleaseRetainedOutputs(Context);
 		ImGui::DestroyContext(Context);
 	}
 }
@@ -90,6 +98,7 @@ void FImGuiContextProxy::DrawEarlyDebug()
 	{
 		bIsDrawEarlyDebugCalled = true;
 
+		ImGuiMemoryTracker::FOwnerScope MemoryOwner{ MemoryCounters };
 		SetAsCurrent();
 
 		// Delegates called in order specified in FImGuiDelegates.
@@ -107,6 +116,7 @@ void FImGuiContextProxy::DrawDebug()
 		// Make sure that early debug is always called first to guarantee order specified in FImGuiDelegates.
 		DrawEarlyDebug();
 
+		ImGuiMemoryTracker::FOwnerScope MemoryOwner{ MemoryCounters };
 		SetAsCurrent();
 
 		// Delegates called in order specified in FImGuiDelegates.
@@ -121,29 +131,110 @@ void FImGuiContextProxy::Tick(float DeltaSeconds)
 	if (LastFrameNumber < GFrameNumber)
 	{
 		LastFrameNumber = GFrameNumber;
+		Update(DeltaSeconds);
+	}
+}
 
-		SetAsCurrent();
+void FImGuiContextProxy::Update(float DeltaSeconds)
+{
+	ImGuiMemoryTracker::FOwnerScope MemoryOwner{ MemoryCounters };
+	SetAsCurrent();
 
-		if (bIsFrameStarted)
-		{
-			// Make sure that draw events are called before the end of the frame.
-			DrawDebug();
+	if (bIsFrameStarted)
+	{
+		// Make sure that draw events are called before the end of the frame.
+		DrawDebug();
 
-			// Ending frame will produce render output that we capture and store for later use. This also puts context to
-			// state in which it does not allow to draw controls, so we want to immediately start a new frame.
-			EndFrame();
-		}
+		// Ending frame will produce render output that we capture and store for later use. This also puts context to
+		// state in which it does not allow to draw controls, so we want to immediately start a new frame.
+		EndFrame();
+	}
+
+	// Update context information (some data, like mouse cursor, may be cleaned in new frame, so we should collect it
+	// beforehand).
+	bHasActiveItem = ImGui::IsAnyItemActive();
+	bIsMouseHoveringAnyWindow = ImGui::IsWindowHovered(ImGuiHoveredFlags_AnyWindow);
+	MouseCursor = ImGuiInterops::ToSlateMouseCursor(ImGui::GetMouseCursor());
+	DisplaySize = ImGuiInterops::ToVector2D(ImGui::GetIO().DisplaySize);
+
+	// Pass settings to storage, when ImGui reports that they changed.
+	if (ImGui::GetIO().WantSaveIniSettings)
+	{
+		SaveSettings();
+	}
+
+	// Begin a new frame and set the context back to a state in which it allows to draw controls.
+	BeginFrame(DeltaSeconds);
+}
+
+void FImGuiContextProxy::SetDisplaySize(const FVector2D& Size)
+{
+	Context->IO.DisplaySize = ImVec2{ Size.X, Size.Y };
+}
+
+void FImGuiContextProxy::Reset()
+{
+	// Release input that might have been held when the previous session ended.
+	InputState.Reset();
+
+	// Keep allocated draw lists but don't render anything until the next frame.
+	DrawLists.Reset();
+
+	bHasActiveItem = false;
+	bIsMouseHoveringAnyWindow = false;
+	bWantsMouseCapture = false;
+	MouseCursor = EMouseCursor::None;
+
+	// Clear ImGui interaction state, so active items, focus or navigation don't carry over to the new session.
+	ImGuiMemoryTracker::FOwnerScope MemoryOwner{ MemoryCounters };
+	SetAsCurrent();
+	ImGui::ClearActiveID();
+	ImGui::FocusWindow(nullptr);
+}
+
+SIZE_T FImGuiContextProxy::GetAllocatedSize() const
+{
+	SIZE_T Size = DrawLists.GetAllocatedSize();
+	for (const FImGuiDrawList& DrawList : DrawLists)
+	{
+		Size += DrawList.GetAllocatedSize();
+	}
 
-		// Update context information (some data, like mouse cursor, may be cleaned in new frame, so we should collect it
-		// beforehand).
-		bHasActiveItem = ImGui::IsAnyItemActive();
-		bIsMouseHoveringAnyWindow = ImGui::IsWindowHovered(ImGuiHoveredFlags_AnyWindow);
-		MouseCursor = ImGuiInterops::ToSlateMouseCursor(ImGui::GetMouseCursor());
-		DisplaySize = ImGuiInterops::ToVector2D(ImGui::GetIO().DisplaySize);
+	for (const ImGuiWindow* Window : Context->Windows)
+	{
+		Size += GetAllocatedBytes(*Window->DrawList) + GetAllocatedBytes(Window->StateStorage.Data);
+	}
+
+	return Size;
+}
+
+SIZE_T FImGuiContextProxy::TrimMemory(bool bKeepDrawData)
+{
+	const SIZE_T SizeBefore = GetAllocatedSize();
+
+	if (!bKeepDrawData)
+	{
+		DrawLists.Empty();
+	}
 
-		// Begin a new frame and set the context back to a state in which it allows to draw controls.
-		BeginFrame(DeltaSeconds);
+	for (ImGuiWindow* Window : Context->Windows)
+	{
+		// Skip windows that are already used in the current frame (like the implicit debug window) and if context is
+		// still in use, also windows that were used in the last frame.
+		if (!Window->Active && !(bKeepDrawData && Window->WasActive))
+		{
+			Window->DrawList->ClearFreeMemory();
+			Window->StateStorage.Clear();
+		}
 	}
+
+	return SizeBefore - GetAllocatedSize();
+}
+
+void FImGuiContextProxy::SaveSettings()
+{
+	SettingsStorage->SaveSettings(Name);
+	ImGui::GetIO().WantSaveIniSettings = false;
 }
 
 void FImGuiContextProxy::BeginFrame(float DeltaTime)
@@ -153,6 +244,19 @@ void FImGuiContextProxy::BeginFrame(float DeltaTime)
 		ImGuiIO& IO = ImGui::GetIO();
 		IO.DeltaTime = DeltaTime;
 
+		// Switch to the latest font atlas, if it was rebuilt.
+		if (&FontAtlas->Get() != &FontAtlasInUse.Get())
+		{
+			FontAtlasInUse = FontAtlas->GetShared();
+			IO.Fonts = &FontAtlasInUse.Get();
+		}
+
+		// Sample cursor as late as possible to reduce latency between hardware cursor and ImGui.
+		if (FSlateApplication::IsInitialized())
+		{
+			InputState.LatchMousePosition(FSlateApplication::Get().GetCursorPos(), DeltaTime);
+		}
+
 		ImGuiInterops::CopyInput(IO, InputState);
 		InputState.ClearUpdateState();
 
@@ -177,6 +281,15 @@ void FImGuiContextProxy::EndFrame()
 		// next frame.
 		UpdateDrawData(ImGui::GetDrawData());
 
+		// Draw data reference atlas texture, so we need to keep that atlas alive for as long as we use them.
+		DrawDataFontAtlas = FontAtlasInUse;
+
+		// Request glyphs that are used in this frame but are not yet rasterised in the font atlas.
+		if (ImDrawData* DrawData = ImGui::GetDrawData())
+		{
+			FontAtlas->RequestGlyphs(FontAtlasInUse.Get(), *DrawData);
+		}
+
 		bIsFrameStarted = false;
 	}
 }
@@ -201,18 +314,20 @@ void FImGuiContextProxy::UpdateDrawData(ImDrawData* DrawData)
 
 void FImGuiContextProxy::BroadcastWorldEarlyDebug()
 {
-	if (ContextIndex != Utilities::INVALID_CONTEXT_INDEX)
+	if (WorldDelegates && WorldDelegates->EarlyDebug.IsBound())
 	{
-		FSimpleMulticastDelegate& WorldEarlyDebugEvent = FImGuiDelegatesContainer::Get().OnWorldEarlyDebug(ContextIndex);
-		if (WorldEarlyDebugEvent.IsBound())
-		{
-			WorldEarlyDebugEvent.Broadcast();
-		}
+		WorldDelegates->EarlyDebug.Broadcast();
 	}
 }
 
 void FImGuiContextProxy::BroadcastMultiContextEarlyDebug()
 {
+	// Offscreen contexts are not part of multi-context events.
+	if (ContextIndex == Utilities::INVALID_CONTEXT_INDEX)
+	{
+		return;
+	}
+
 	FSimpleMulticastDelegate& MultiContextEarlyDebugEvent = FImGuiDelegatesContainer::Get().OnMultiContextEarlyDebug();
 	if (MultiContextEarlyDebugEvent.IsBound())
 	{
@@ -227,13 +342,13 @@ void FImGuiContextProxy::BroadcastWorldDebug()
 		DrawEvent.Broadcast();
 	}
 
-	if (ContextIndex != Utilities::INVALID_CONTEXT_INDEX)
+	if (WorldDelegates)
 	{
-		FSimpleMulticastDelegate& WorldDebugEvent = FImGuiDelegatesContainer::Get().OnWorldDebug(ContextIndex);
-		if (WorldDebugEvent.IsBound())
+		if (WorldDelegates->Debug.IsBound())
 		{
-			WorldDebugEvent.Broadcast();
+			WorldDelegates->Debug.Broadcast();
 		}
+		WorldDelegates->DebugListeners.Invoke();
 	}
 }
 
@@ -244,9 +359,17 @@ void FImGuiContextProxy::BroadcastMultiContextDebug()
 		SharedDrawEvent->Broadcast();
 	}
 
+	// Offscreen contexts are not part of multi-context events.
+	if (ContextIndex == Utilities::INVALID_CONTEXT_INDEX)
+	{
+		return;
+	}
+
 	FSimpleMulticastDelegate& MultiContextDebugEvent = FImGuiDelegatesContainer::Get().OnMultiContextDebug();
 	if (MultiContextDebugEvent.IsBound())
 	{
 		MultiContextDebugEvent.Broadcast();
 	}
+
+	FImGuiDelegatesContainer::Get().GetMultiContextDebugListeners().Invoke();
 }
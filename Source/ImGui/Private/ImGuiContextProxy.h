@@ -2,16 +2,19 @@
 
 #pragma once
 
+#include "ImGuiDelegatesContainer.h"
 #include "ImGuiDrawData.h"
 #include "ImGuiInputState.h"
+#include "ImGuiMemoryTracker.h"
 #include "Utilities/WorldContextIndex.h"
 
 #include <GenericPlatform/ICursor.h>
 
 #include <imgui.h>
 
-#include <string>
 
+class FImGuiFontAtlas;
+class FImGuiSettingsStorage;
 
 // Represents a single ImGui context. All the context updates should be done through this proxy. During update it
 // broadcasts draw events to allow listeners draw their controls. After update it stores draw data.
@@ -19,7 +22,8 @@ class FImGuiContextProxy
 {
 public:
 
-	FImGuiContextProxy(const FString& Name, int32 InContextIndex, FSimpleMulticastDelegate* InSharedDrawEvent, ImFontAtlas* InFontAtlas);
+	FImGuiContextProxy(const FString& Name, int32 InContextIndex, FSimpleMulticastDelegate* InSharedDrawEvent, FImGuiFontAtlas* InFontAtlas,
+		FImGuiSettingsStorage* InSettingsStorage);
 	~FImGuiContextProxy();
 
 	FImGuiContextProxy(const FImGuiContextProxy&) = delete;
@@ -34,6 +38,9 @@ public:
 	// Get draw data from the last frame.
 	const TArray<FImGuiDrawList>& GetDrawData() const { return DrawLists; }
 
+	// Get font atlas used to generate draw data from the last frame.
+	const ImFontAtlas* GetDrawDataFontAtlas() const { return DrawDataFontAtlas.Get(); }
+
 	// Get input state used by this context.
 	FImGuiInputState& GetInputState() { return InputState; }
 	const FImGuiInputState& GetInputState() const { return InputState; }
@@ -71,6 +78,30 @@ public:
 	// Tick to advance context to the next frame. Only one call per frame will be processed.
 	void Tick(float DeltaSeconds);
 
+	// Advance context to the next frame, regardless of the engine frame number. Allows to update offscreen contexts
+	// on demand, also when engine doesn't advance frames (like in commandlets).
+	void Update(float DeltaSeconds);
+
+	// Set display size for the next frame. Allows to define canvas size for offscreen contexts.
+	void SetDisplaySize(const FVector2D& Size);
+
+	// Reset input, draw data and interaction state, so context can be reused by another session. Allocations, window
+	// settings are kept.
+	void Reset();
+
+	// Get the estimated size of memory allocated by this context for draw data and window storage.
+	SIZE_T GetAllocatedSize() const;
+
+	// Release memory that is only needed when context is updated, like draw lists and window storage. Released memory
+	// is re-allocated during the next update, so it should be used only for contexts that are no longer used.
+	// @param bKeepDrawData - Whether to keep draw data from the last frame, so context that is in use can be trimmed
+	//     without losing its output (only storage of windows not used in the last frame is released)
+	// @returns Estimated size of released memory
+	SIZE_T TrimMemory(bool bKeepDrawData = false);
+
+	// Get counters of memory allocated by ImGui on behalf of this context.
+	const FImGuiMemoryCounters& GetMemoryCounters() const { return MemoryCounters; }
+
 private:
 
 	void BeginFrame(float DeltaTime = 1.f / 60.f);
@@ -78,6 +109,8 @@ private:
 
 	void UpdateDrawData(ImDrawData* DrawData);
 
+	void SaveSettings();
+
 	void BroadcastWorldEarlyDebug();
 	void BroadcastMultiContextEarlyDebug();
 
@@ -103,6 +136,7 @@ private:
 	TArray<FImGuiDrawList> DrawLists;
 
 	FString Name;
+	FImGuiMemoryCounters& MemoryCounters;
 	int32 ContextIndex = Utilities::INVALID_CONTEXT_INDEX;
 
 	uint32 LastFrameNumber = 0;
@@ -110,5 +144,12 @@ private:
 	FSimpleMulticastDelegate DrawEvent;
 	FSimpleMulticastDelegate* SharedDrawEvent = nullptr;
 
-	std::string IniFilename;
+	// Delegates of the world with this context index (null for offscreen contexts).
+	FImGuiDelegatesContainer::FWorldDelegates* WorldDelegates = nullptr;
+
+	FImGuiFontAtlas* FontAtlas = nullptr;
+	TSharedRef<ImFontAtlas> FontAtlasInUse;
+	TSharedPtr<ImFontAtlas> DrawDataFontAtlas;
+
+	FImGuiSettingsStorage* SettingsStorage = nullptr;
 };
@@ -0,0 +1,208 @@
+// Distributed under the MIT License (MIT) (see accompanying LICENSE file)
+
+#include "ImGuiPrivatePCH.h"
+
+#include "ImGuiDebugListener.h"
+
+#include <imgui.h>
+
+
+// Limit for throttling, so listeners that are far over their budget are still updated a few times per second.
+static constexpr int32 MAX_THROTTLE_INTERVAL = 30;
+
+FImGuiDebugListener::FImGuiDebugListener(const FName& InName, const FSimpleDelegate& InDelegate, const FImGuiListenerOptions& InOptions)
+	: Name(InName)
+	, Delegate(InDelegate)
+	, Options(InOptions)
+	, ThrottlePhase(GetTypeHash(InName))
+#if STATS
+	, StatId(FDynamicStats::CreateStatId<FStatGroup_STATGROUP_ImGuiListeners>(InName.ToString()))
+#endif
+{
+}
+
+void FImGuiDebugListener::Invoke()
+{
+	const bool bVersioned = Options.Version.IsBound();
+	const bool bRetained = (Options.bRetainOutput && CanSkipFrames()) || bVersioned;
+
+	if (!IsScheduled())
+	{
+		SkipCount++;
+
+		if (bRetained)
+		{
+			if (FImGuiRetainedOutput* Output = RetainedOutputs.Find(ImGui::GetCurrentContext()))
+			{
+				Output->Replay();
+			}
+		}
+		return;
+	}
+
+	FImGuiRetainedOutput* Output = bRetained ? &RetainedOutputs.FindOrAdd(ImGui::GetCurrentContext()) : nullptr;
+
+	// If data didn't change since the last invocation, replay its output instead of drawing it again.
+	const uint64 Version = bVersioned ? Options.Version.Execute() : 0;
+	if (bVersioned && Output->IsReusable(Version))
+	{
+		ReplayCount++;
+		Output->Replay();
+		return;
+	}
+
+	if (Output)
+	{
+		Output->BeginRecording();
+	}
+
+	const uint32 StartCycles = FPlatformTime::Cycles();
+	{
+#if STATS
+		FScopeCycleCounter CycleCounter(StatId);
+#endif
+		Delegate.ExecuteIfBound();
+	}
+	AddSample(static_cast<float>(FPlatformTime::ToMilliseconds(FPlatformTime::Cycles() - StartCycles)));
+
+	if (Output)
+	{
+		Output->EndRecording();
+		if (bVersioned)
+		{
+			Output->SetVersion(Version);
+		}
+	}
+
+	InvocationCount++;
+
+	if (Options.Budget > 0.f)
+	{
+		// Throttle, so the average cost per frame fits within the budget.
+		ThrottleInterval = FMath::Clamp(FMath::CeilToInt(GetAverageTime() / Options.Budget), 1, MAX_THROTTLE_INTERVAL);
+	}
+}
+
+void FImGuiDebugListener::SetTimeSlice(int32 Index, int32 Count)
+{
+	SliceIndex = Index;
+	SliceCount = FMath::Max(Count, 1);
+}
+
+bool FImGuiDebugListener::IsScheduled() const
+{
+	// Number of frames between invocations of this listener, if it wasn't time-sliced.
+	const uint64 Step = static_cast<uint64>(FMath::Max(Options.Interval, 1)) * ThrottleInterval;
+
+	if (SliceCount > 1)
+	{
+		// Listeners in the same group share a period and each of them is invoked in its own frame.
+		return GFrameCounter % (Step * SliceCount) == SliceIndex * Step;
+	}
+
+	return Step == 1 || (GFrameCounter + ThrottlePhase) % Step == 0;
+}
+
+bool FImGuiDebugListener::CanSkipFrames() const
+{
+	return Options.Interval > 1 || !Options.TimeSliceGroup.IsNone() || Options.Budget > 0.f;
+}
+
+float FImGuiDebugListener::GetMaxTime() const
+{
+	float MaxTime = 0.f;
+	for (int32 Index = 0; Index < NumSamples; Index++)
+	{
+		MaxTime = FMath::Max(MaxTime, Samples[Index]);
+	}
+	return MaxTime;
+}
+
+void FImGuiDebugListener::AddSample(float Time)
+{
+	if (NumSamples < MaxSamples)
+	{
+		NumSamples++;
+	}
+	else
+	{
+		SamplesSum -= Samples[SampleIndex];
+	}
+
+	Samples[SampleIndex] = Time;
+	SamplesSum += Time;
+	SampleIndex = (SampleIndex + 1) % MaxSamples;
+}
+
+FDelegateHandle FImGuiListenerList::Add(const TSharedRef<FImGuiDebugListener>& Listener)
+{
+	Listener->Handle = FDelegateHandle(FDelegateHandle::GenerateNewHandle);
+
+	// Insert after listeners with the same or higher priority, so those with the same priority keep order of adding.
+	const int32 Priority = Listener->GetOptions().Priority;
+	int32 Index = 0;
+	while (Index < Listeners.Num() && Listeners[Index]->GetOptions().Priority >= Priority)
+	{
+		Index++;
+	}
+	Listeners.Insert(Listener, Index);
+
+	if (!Listener->GetOptions().TimeSliceGroup.IsNone())
+	{
+		UpdateTimeSlices();
+	}
+
+	return Listener->Handle;
+}
+
+void FImGuiListenerList::Remove(const FDelegateHandle& Handle)
+{
+	const int32 Index = Listeners.IndexOfByPredicate([&](const TSharedRef<FImGuiDebugListener>& Listener)
+	{
+		return Listener->GetHandle() == Handle;
+	});
+
+	if (Index != INDEX_NONE)
+	{
+		const bool bTimeSliced = !Listeners[Index]->GetOptions().TimeSliceGroup.IsNone();
+		Listeners.RemoveAt(Index);
+
+		if (bTimeSliced)
+		{
+			UpdateTimeSlices();
+		}
+	}
+}
+
+void FImGuiListenerList::Invoke()
+{
+	// Listeners can add or remove listeners, so we iterate over a copy.
+	const TArray<TSharedRef<FImGuiDebugListener>> InvokedListeners = Listeners;
+	for (const TSharedRef<FImGuiDebugListener>& Listener : InvokedListeners)
+	{
+		Listener->Invoke();
+	}
+}
+
+void FImGuiListenerList::UpdateTimeSlices()
+{
+	TMap<FName, int32> GroupSizes;
+	for (const TSharedRef<FImGuiDebugListener>& Listener : Listeners)
+	{
+		const FName& Group = Listener->GetOptions().TimeSliceGroup;
+		if (!Group.IsNone())
+		{
+			GroupSizes.FindOrAdd(Group)++;
+		}
+	}
+
+	TMap<FName, int32> GroupIndices;
+	for (const TSharedRef<FImGuiDebugListener>& Listener : Listeners)
+	{
+		const FName& Group = Listener->GetOptions().TimeSliceGroup;
+		if (!Group.IsNone())
+		{
+			Listener->SetTimeSlice(GroupIndices.FindOrAdd(Group)++, GroupSizes[Group]);
+		}
+	}
+}
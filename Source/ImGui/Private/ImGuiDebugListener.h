@@ -0,0 +1,133 @@
+// Distributed under the MIT License (MIT) (see accompanying LICENSE file)
+
+#pragma once
+
+#include "ImGuiDelegates.h"
+#include "ImGuiRetainedOutput.h"
+
+#include <Stats/Stats.h>
+
+
+DECLARE_STATS_GROUP(TEXT("ImGui Listeners"), STATGROUP_ImGuiListeners, STATCAT_Advanced);
+
+struct ImGuiContext;
+
+// Named listener of ImGui debug events. Listeners are invoked by listener lists, which allows to time each listener
+// separately and to schedule them according to their priorities, intervals and budgets.
+class FImGuiDebugListener
+{
+public:
+
+	FImGuiDebugListener(const FName& InName, const FSimpleDelegate& InDelegate, const FImGuiListenerOptions& InOptions);
+
+	// Invoke the delegate, if listener is scheduled for this frame, and update timing. In other frames, replay the last
+	// output, if listener retains it.
+	void Invoke();
+
+	// Get the name identifying this listener.
+	const FName& GetName() const { return Name; }
+
+	// Get the handle identifying this listener in its list.
+	const FDelegateHandle& GetHandle() const { return Handle; }
+
+	// Get the options with which this listener was registered.
+	const FImGuiListenerOptions& GetOptions() const { return Options; }
+
+	// Get the average time in milliseconds of the recent invocations.
+	float GetAverageTime() const { return NumSamples > 0 ? static_cast<float>(SamplesSum / NumSamples) : 0.f; }
+
+	// Get the maximal time in milliseconds of the recent invocations.
+	float GetMaxTime() const;
+
+	// Get the number of frames between invocations: one if listener is not throttled.
+	int32 GetThrottleInterval() const { return ThrottleInterval; }
+
+	// Get the number of times this listener was invoked.
+	uint64 GetInvocationCount() const { return InvocationCount; }
+
+	// Get the number of times this listener was skipped because of its interval, time-slicing or throttling.
+	uint64 GetSkipCount() const { return SkipCount; }
+
+	// Get the number of times output of this listener was replayed, because version of its data didn't change.
+	uint64 GetReplayCount() const { return ReplayCount; }
+
+	// Set the position of this listener in its time-slice group.
+	// @param Index - Index of this listener in the group
+	// @param Count - Number of listeners in the group
+	void SetTimeSlice(int32 Index, int32 Count);
+
+	// Release output retained for a context, which is about to be destroyed.
+	void ReleaseRetainedOutput(const ImGuiContext* Context) { RetainedOutputs.Remove(Context); }
+
+private:
+
+	bool IsScheduled() const;
+
+	// Whether this listener can be skipped in some frames, so it needs to retain its output to replay it.
+	bool CanSkipFrames() const;
+
+	void AddSample(float Time);
+
+	static constexpr int32 MaxSamples = 64;
+
+	FName Name;
+	FSimpleDelegate Delegate;
+	FImGuiListenerOptions Options;
+	FDelegateHandle Handle;
+
+	// Ring of the recent invocation times in milliseconds.
+	float Samples[MaxSamples];
+	double SamplesSum = 0.0;
+	int32 SampleIndex = 0;
+	int32 NumSamples = 0;
+
+	// Offset of frames in which throttled listener is invoked, so throttled listeners don't run in the same frames.
+	uint32 ThrottlePhase = 0;
+	int32 ThrottleInterval = 1;
+
+	int32 SliceIndex = 0;
+	int32 SliceCount = 1;
+
+	// Last output in every context in which this listener is invoked. Entries are released when contexts are destroyed,
+	// so they are not replayed in new contexts allocated at the same address.
+	TMap<const ImGuiContext*, FImGuiRetainedOutput> RetainedOutputs;
+
+	uint64 InvocationCount = 0;
+	uint64 SkipCount = 0;
+	uint64 ReplayCount = 0;
+
+#if STATS
+	TStatId StatId;
+#endif
+
+	friend class FImGuiListenerList;
+};
+
+// List of named listeners of a single debug event, sorted by priority.
+class FImGuiListenerList
+{
+public:
+
+	// Add a listener to this list.
+	// @param Listener - Listener to add
+	// @returns Handle that can be used to remove the listener
+	FDelegateHandle Add(const TSharedRef<FImGuiDebugListener>& Listener);
+
+	// Remove a listener with given handle.
+	void Remove(const FDelegateHandle& Handle);
+
+	// Remove all listeners.
+	void Clear() { Listeners.Empty(); }
+
+	// Whether this list has no listeners.
+	bool IsEmpty() const { return Listeners.Num() == 0; }
+
+	// Invoke listeners in order of their priorities.
+	void Invoke();
+
+private:
+
+	void UpdateTimeSlices();
+
+	TArray<TSharedRef<FImGuiDebugListener>> Listeners;
+};
@@ -6,6 +6,19 @@
 #include "ImGuiDelegatesContainer.h"
 
 
+namespace
+{
+	FDelegateHandle AddListener(FImGuiListenerList& List, const FName& Name, const FSimpleDelegate& Delegate,
+		const FImGuiListenerOptions& Options)
+	{
+		// Listener is owned by its list, so it is released when it is removed or when list is cleared.
+		TSharedRef<FImGuiDebugListener> Listener = MakeShareable(new FImGuiDebugListener(Name, Delegate, Options));
+		FImGuiDelegatesContainer::Get().RegisterListener(Listener);
+		return List.Add(Listener);
+	}
+}
+
+
 FSimpleMulticastDelegate& FImGuiDelegates::OnWorldEarlyDebug()
 {
 	return OnWorldEarlyDebug(GWorld);
@@ -35,3 +48,30 @@ FSimpleMulticastDelegate& FImGuiDelegates::OnMultiContextDebug()
 {
 	return FImGuiDelegatesContainer::Get().OnMultiContextDebug();
 }
+
+FSimpleMulticastDelegate& FImGuiDelegates::OnOffscreenDebug(const FName& ContextName)
+{
+	return FImGuiDelegatesContainer::Get().OnOffscreenDebug(ContextName);
+}
+
+FDelegateHandle FImGuiDelegates::AddWorldDebugListener(UWorld* World, const FName& Name, const FSimpleDelegate& Delegate,
+	const FImGuiListenerOptions& Options)
+{
+	return AddListener(FImGuiDelegatesContainer::Get().GetWorldDelegates(World).DebugListeners, Name, Delegate, Options);
+}
+
+void FImGuiDelegates::RemoveWorldDebugListener(UWorld* World, const FDelegateHandle& Handle)
+{
+	FImGuiDelegatesContainer::Get().GetWorldDelegates(World).DebugListeners.Remove(Handle);
+}
+
+FDelegateHandle FImGuiDelegates::AddMultiContextDebugListener(const FName& Name, const FSimpleDelegate& Delegate,
+	const FImGuiListenerOptions& Options)
+{
+	return AddListener(FImGuiDelegatesContainer::Get().GetMultiContextDebugListeners(), Name, Delegate, Options);
+}
+
+void FImGuiDelegates::RemoveMultiContextDebugListener(const FDelegateHandle& Handle)
+{
+	FImGuiDelegatesContainer::Get().GetMultiContextDebugListeners().Remove(Handle);
+}
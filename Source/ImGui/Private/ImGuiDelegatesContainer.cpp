@@ -17,7 +17,7 @@ void FImGuiDelegatesContainer::MoveContainer(FImGuiDelegatesContainer& Dst)
 	// keep pointer to a more recent version.
 	if (InstancePtr == &DefaultInstance)
 	{
-		Dst = MoveTemp(DefaultInstance);
+		Dst.MoveDelegates(DefaultInstance);
 		DefaultInstance.Clear();
 	}
 
@@ -25,15 +25,114 @@ void FImGuiDelegatesContainer::MoveContainer(FImGuiDelegatesContainer& Dst)
 	InstancePtr = &Dst;
 }
 
+FSimpleMulticastDelegate& FImGuiDelegatesContainer::OnOffscreenDebug(const FName& ContextName)
+{
+	TUniquePtr<FSimpleMulticastDelegate>& Delegate = OffscreenDebugDelegates.FindOrAdd(ContextName);
+	if (!Delegate)
+	{
+		Delegate = MakeUnique<FSimpleMulticastDelegate>();
+	}
+	return *Delegate;
+}
+
+FImGuiDelegatesContainer::FWorldDelegates& FImGuiDelegatesContainer::GetWorldDelegates(int32 ContextIndex)
+{
+	if (ContextIndex < 0)
+	{
+		return InvalidWorldDelegates;
+	}
+
+	while (WorldDelegates.Num() <= ContextIndex)
+	{
+		WorldDelegates.Add(new FWorldDelegates());
+	}
+
+	return WorldDelegates[ContextIndex];
+}
+
+void FImGuiDelegatesContainer::GetListeners(TArray<TSharedPtr<FImGuiDebugListener>>& OutListeners)
+{
+	OutListeners.Reset(Listeners.Num());
+
+	for (int32 Index = Listeners.Num() - 1; Index >= 0; Index--)
+	{
+		TSharedPtr<FImGuiDebugListener> Listener = Listeners[Index].Pin();
+		if (Listener.IsValid())
+		{
+			OutListeners.Add(Listener);
+		}
+		else
+		{
+			Listeners.RemoveAtSwap(Index, 1, false);
+		}
+	}
+}
+
+void FImGuiDelegatesContainer::ReleaseRetainedOutputs(const ImGuiContext* Context)
+{
+	for (const TWeakPtr<FImGuiDebugListener>& WeakListener : Listeners)
+	{
+		if (TSharedPtr<FImGuiDebugListener> Listener = WeakListener.Pin())
+		{
+			Listener->ReleaseRetainedOutput(Context);
+		}
+	}
+}
+
 int32 FImGuiDelegatesContainer::GetContextIndex(UWorld* World)
 {
 	return Utilities::GetWorldContextIndex(*World);
 }
 
+void FImGuiDelegatesContainer::MoveDelegates(FImGuiDelegatesContainer& Src)
+{
+	for (int32 Index = 0; Index < Src.WorldDelegates.Num(); Index++)
+	{
+		FWorldDelegates& Delegates = GetWorldDelegates(Index);
+		Delegates.EarlyDebug = MoveTemp(Src.WorldDelegates[Index].EarlyDebug);
+		Delegates.Debug = MoveTemp(Src.WorldDelegates[Index].Debug);
+		Delegates.DebugListeners = MoveTemp(Src.WorldDelegates[Index].DebugListeners);
+	}
+
+	for (auto& Entry : Src.OffscreenDebugDelegates)
+	{
+		if (Entry.Value)
+		{
+			OnOffscreenDebug(Entry.Key) = MoveTemp(*Entry.Value);
+		}
+	}
+
+	MultiContextEarlyDebugDelegate = MoveTemp(Src.MultiContextEarlyDebugDelegate);
+	MultiContextDebugDelegate = MoveTemp(Src.MultiContextDebugDelegate);
+	MultiContextDebugListeners = MoveTemp(Src.MultiContextDebugListeners);
+
+	Listeners.Append(MoveTemp(Src.Listeners));
+}
+
 void FImGuiDelegatesContainer::Clear()
 {
-	WorldEarlyDebugDelegates.Empty();
-	WorldDebugDelegates.Empty();
+	// Delegates are cleared but not released, because contexts can keep references to them.
+	for (FWorldDelegates& Delegates : WorldDelegates)
+	{
+		Delegates.EarlyDebug.Clear();
+		Delegates.Debug.Clear();
+		Delegates.DebugListeners.Clear();
+	}
+	InvalidWorldDelegates.EarlyDebug.Clear();
+	InvalidWorldDelegates.Debug.Clear();
+	InvalidWorldDelegates.DebugListeners.Clear();
+
+	for (auto& Entry : OffscreenDebugDelegates)
+	{
+		if (Entry.Value)
+		{
+			Entry.Value->Clear();
+		}
+	}
+
 	MultiContextEarlyDebugDelegate.Clear();
 	MultiContextDebugDelegate.Clear();
+	MultiContextDebugListeners.Clear();
+
+	Listeners.Empty();
 }
@@ -2,14 +2,30 @@
 
 #pragma once
 
+#include "ImGuiDebugListener.h"
+
+#include <Containers/IndirectArray.h>
 #include <Containers/Map.h>
 #include <Delegates/Delegate.h>
+#include <Templates/SharedPointer.h>
+#include <Templates/UniquePtr.h>
 
 
 struct FImGuiDelegatesContainer
 {
 public:
 
+	// Delegates of a single world. Those are allocated separately and never released, so contexts can keep references
+	// to them and broadcast without lookups.
+	struct FWorldDelegates
+	{
+		FSimpleMulticastDelegate EarlyDebug;
+		FSimpleMulticastDelegate Debug;
+
+		// Named listeners invoked after the debug delegate.
+		FImGuiListenerList DebugListeners;
+	};
+
 	// Get the current instance (can change during hot-reloading).
 	static FImGuiDelegatesContainer& Get() { return *InstancePtr; }
 
@@ -20,7 +36,7 @@ public:
 	FSimpleMulticastDelegate& OnWorldEarlyDebug(UWorld* World) { return OnWorldEarlyDebug(GetContextIndex(World)); }
 
 	// Get delegate to ImGui world early debug event from known context index.
-	FSimpleMulticastDelegate& OnWorldEarlyDebug(int32 ContextIndex) { return WorldEarlyDebugDelegates.FindOrAdd(ContextIndex); }
+	FSimpleMulticastDelegate& OnWorldEarlyDebug(int32 ContextIndex) { return GetWorldDelegates(ContextIndex).EarlyDebug; }
 
 	// Get delegate to ImGui multi-context early debug event.
 	FSimpleMulticastDelegate& OnMultiContextEarlyDebug() { return MultiContextEarlyDebugDelegate; }
@@ -29,21 +45,55 @@ public:
 	FSimpleMulticastDelegate& OnWorldDebug(UWorld* World) { return OnWorldDebug(GetContextIndex(World)); }
 
 	// Get delegate to ImGui world debug event from known context index.
-	FSimpleMulticastDelegate& OnWorldDebug(int32 ContextIndex) { return WorldDebugDelegates.FindOrAdd(ContextIndex); }
+	FSimpleMulticastDelegate& OnWorldDebug(int32 ContextIndex) { return GetWorldDelegates(ContextIndex).Debug; }
 
 	// Get delegate to ImGui multi-context debug event.
 	FSimpleMulticastDelegate& OnMultiContextDebug() { return MultiContextDebugDelegate; }
 
+	// Get named listeners invoked after the multi-context debug delegate.
+	FImGuiListenerList& GetMultiContextDebugListeners() { return MultiContextDebugListeners; }
+
+	// Get delegate to ImGui offscreen debug event for given offscreen context. Returned reference stays valid for the
+	// lifetime of this container, including after its data is moved during hot-reloading.
+	FSimpleMulticastDelegate& OnOffscreenDebug(const FName& ContextName);
+
+	// Get delegates of a world with given context index, creating them on the first call. Returned reference stays
+	// valid for the lifetime of this container, including after its data is moved during hot-reloading.
+	FWorldDelegates& GetWorldDelegates(int32 ContextIndex);
+
+	// Get delegates of a known world instance (@see GetWorldDelegates).
+	FWorldDelegates& GetWorldDelegates(UWorld* World) { return GetWorldDelegates(GetContextIndex(World)); }
+
+	// Register a named listener, so it can be found for stats. Registry doesn't own listeners.
+	void RegisterListener(const TSharedRef<FImGuiDebugListener>& Listener) { Listeners.Add(Listener); }
+
+	// Get all named listeners that are still bound, releasing entries of those that are not.
+	void GetListeners(TArray<TSharedPtr<FImGuiDebugListener>>& OutListeners);
+
+	// Release output that named listeners retained for a context, which is about to be destroyed.
+	void ReleaseRetainedOutputs(const ImGuiContext* Context);
+
 private:
 
 	int32 GetContextIndex(UWorld* World);
 
+	// Move delegates to this container. Delegates are moved into existing slots, so references to them stay valid.
+	void MoveDelegates(FImGuiDelegatesContainer& Src);
+
 	void Clear();
 
-	TMap<int32, FSimpleMulticastDelegate> WorldEarlyDebugDelegates;
-	TMap<int32, FSimpleMulticastDelegate> WorldDebugDelegates;
+	// Indexed by context index.
+	TIndirectArray<FWorldDelegates> WorldDelegates;
+
+	// Collects registrations for invalid context index, which are never broadcast.
+	FWorldDelegates InvalidWorldDelegates;
+
+	TMap<FName, TUniquePtr<FSimpleMulticastDelegate>> OffscreenDebugDelegates;
+
+	TArray<TWeakPtr<FImGuiDebugListener>> Listeners;
 	FSimpleMulticastDelegate MultiContextEarlyDebugDelegate;
 	FSimpleMulticastDelegate MultiContextDebugDelegate;
+	FImGuiListenerList MultiContextDebugListeners;
 
 	// Default container instance.
 	static FImGuiDelegatesContainer DefaultInstance;
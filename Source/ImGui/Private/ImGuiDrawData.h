@@ -57,6 +57,22 @@ public:
 	// @param NumElements - How many elements we want to copy
 	void CopyIndexData(TArray<SlateIndex>& OutIndexBuffer, const int32 StartIndex, const int32 NumElements) const;
 
+	// Get raw ImGui draw commands, e.g. for rendering outside of Slate.
+	FORCEINLINE const ImVector<ImDrawCmd>& GetImGuiCommands() const { return ImGuiCommandBuffer; }
+
+	// Get raw ImGui index buffer.
+	FORCEINLINE const ImVector<ImDrawIdx>& GetImGuiIndices() const { return ImGuiIndexBuffer; }
+
+	// Get raw ImGui vertex buffer (untransformed).
+	FORCEINLINE const ImVector<ImDrawVert>& GetImGuiVertices() const { return ImGuiVertexBuffer; }
+
+	// Get the size of memory allocated by this list.
+	SIZE_T GetAllocatedSize() const
+	{
+		return ImGuiCommandBuffer.Capacity * sizeof(ImDrawCmd) + ImGuiIndexBuffer.Capacity * sizeof(ImDrawIdx)
+			+ ImGuiVertexBuffer.Capacity * sizeof(ImDrawVert);
+	}
+
 	// Transfers data from ImGui source list to this object. Leaves source cleared.
 	void TransferDrawData(ImDrawList& Src);
 
@@ -0,0 +1,694 @@
+// Distributed under the MIT License (MIT) (see accompanying LICENSE file)
+
+#include "ImGuiPrivatePCH.h"
+
+#include "ImGuiFontAtlas.h"
+
+#include "ImGuiImplementation.h"
+#include "ImGuiModuleSettings.h"
+#include "Utilities/Paths.h"
+
+#include <HAL/FileManager.h>
+#include <HAL/PlatformFilemanager.h>
+#include <Misc/SecureHash.h>
+#include <Serialization/BufferReader.h>
+
+#if ENGINE_COMPATIBILITY_WITH_MAPPED_FILES
+#include <Async/MappedFileHandle.h>
+#endif
+
+#include <imgui_internal.h>
+
+
+namespace
+{
+	// Id of a custom rectangle reserved for the dynamic glyph cache (ImGui requires ids of regular rectangles to be
+	// outside of the Unicode range).
+	constexpr unsigned int DYNAMIC_GLYPH_CACHE_RECT_ID = 0x110000;
+
+	// Limit of glyphs rasterised in one update. It spreads the cost of big requests across a few frames.
+	constexpr int32 MAX_GLYPHS_PER_UPDATE = 64;
+
+	const ImWchar* GetGlyphRanges(ImFontAtlas& Atlas, EImGuiGlyphRanges Ranges)
+	{
+		switch (Ranges)
+		{
+		case EImGuiGlyphRanges::Cyrillic:
+			return Atlas.GetGlyphRangesCyrillic();
+		case EImGuiGlyphRanges::Japanese:
+			return Atlas.GetGlyphRangesJapanese();
+		case EImGuiGlyphRanges::Korean:
+			return Atlas.GetGlyphRangesKorean();
+		case EImGuiGlyphRanges::ChineseFull:
+			return Atlas.GetGlyphRangesChineseFull();
+		case EImGuiGlyphRanges::ChineseSimplifiedCommon:
+			return Atlas.GetGlyphRangesChineseSimplifiedCommon();
+		case EImGuiGlyphRanges::Thai:
+			return Atlas.GetGlyphRangesThai();
+		case EImGuiGlyphRanges::Vietnamese:
+			return Atlas.GetGlyphRangesVietnamese();
+		default:
+			return Atlas.GetGlyphRangesDefault();
+		}
+	}
+
+	FString GetFontPath(const FFilePath& File)
+	{
+		if (FPaths::IsRelative(File.FilePath))
+		{
+#if ENGINE_COMPATIBILITY_LEGACY_SAVED_DIR
+			return FPaths::Combine(FPaths::GameDir(), File.FilePath);
+#else
+			return FPaths::Combine(FPaths::ProjectDir(), File.FilePath);
+#endif
+		}
+		return File.FilePath;
+	}
+
+	// Load font data to a buffer allocated with ImGui allocator, so ownership can be transferred to the font atlas.
+	void* LoadFontData(const FString& Path, int32& OutSize)
+	{
+		TUniquePtr<FArchive> Reader{ IFileManager::Get().CreateFileReader(*Path) };
+		if (!Reader)
+		{
+			return nullptr;
+		}
+
+		OutSize = static_cast<int32>(Reader->TotalSize());
+		void* Data = IM_ALLOC(OutSize);
+		Reader->Serialize(Data, OutSize);
+		return Data;
+	}
+
+	// Identifies cache files and their format. Increase version whenever format or build data change.
+	constexpr uint32 CACHE_MAGIC = 0x41464749; // 'IGFA'
+	constexpr uint32 CACHE_VERSION = 1;
+
+	FString GetCacheFile()
+	{
+		return FPaths::Combine(Utilities::GetSaveDirectory(), TEXT("FontAtlas.bin"));
+	}
+
+	// Serialise data produced by atlas build. When loading, atlas needs to have the same configuration as when
+	// saving, which is guaranteed by a cache key.
+	bool SerializeBuildData(FArchive& Ar, ImFontAtlas& Atlas)
+	{
+		Ar << Atlas.TexWidth << Atlas.TexHeight;
+		if (Ar.IsLoading() && (Atlas.TexWidth <= 0 || Atlas.TexHeight <= 0 || Atlas.TexWidth * Atlas.TexHeight > Ar.TotalSize()))
+		{
+			return false;
+		}
+
+		int32 NumCustomRects = Atlas.CustomRects.Size;
+		Ar << NumCustomRects;
+		if (NumCustomRects != Atlas.CustomRects.Size)
+		{
+			return false;
+		}
+
+		for (ImFontAtlasCustomRect& Rect : Atlas.CustomRects)
+		{
+			Ar << Rect.X << Rect.Y;
+		}
+
+		int32 NumFonts = Atlas.Fonts.Size;
+		Ar << NumFonts;
+		if (NumFonts != Atlas.Fonts.Size)
+		{
+			return false;
+		}
+
+		for (ImFont* Font : Atlas.Fonts)
+		{
+			int32 ConfigIndex = Font->ConfigData ? static_cast<int32>(Font->ConfigData - Atlas.ConfigData.Data) : INDEX_NONE;
+			int32 NumGlyphs = Font->Glyphs.Size;
+			Ar << ConfigIndex << Font->ConfigDataCount << Font->FontSize << Font->Ascent << Font->Descent
+				<< Font->MetricsTotalSurface << NumGlyphs;
+
+			if (Ar.IsLoading())
+			{
+				if (ConfigIndex < INDEX_NONE || ConfigIndex >= Atlas.ConfigData.Size || NumGlyphs < 0
+					|| NumGlyphs * static_cast<int64>(sizeof(ImFontGlyph)) > Ar.TotalSize() - Ar.Tell())
+				{
+					return false;
+				}
+
+				Font->ConfigData = (ConfigIndex != INDEX_NONE) ? &Atlas.ConfigData[ConfigIndex] : nullptr;
+				Font->ContainerAtlas = Font->ConfigData ? &Atlas : nullptr;
+				Font->Glyphs.resize(NumGlyphs);
+			}
+
+			Ar.Serialize(Font->Glyphs.Data, NumGlyphs * sizeof(ImFontGlyph));
+		}
+
+		const int32 NumPixels = Atlas.TexWidth * Atlas.TexHeight;
+		if (Ar.IsLoading())
+		{
+			if (NumPixels != Ar.TotalSize() - Ar.Tell())
+			{
+				return false;
+			}
+
+			Atlas.TexPixelsAlpha8 = static_cast<unsigned char*>(IM_ALLOC(NumPixels));
+			Atlas.TexUvScale = ImVec2(1.0f / Atlas.TexWidth, 1.0f / Atlas.TexHeight);
+		}
+
+		Ar.Serialize(Atlas.TexPixelsAlpha8, NumPixels);
+
+		return !Ar.IsError();
+	}
+
+	FORCEINLINE uint32 GetGlyphKey(int ConfigIndex, ImWchar Codepoint)
+	{
+		return (static_cast<uint32>(ConfigIndex) << 16) | Codepoint;
+	}
+
+	FORCEINLINE int GetConfigIndex(uint32 GlyphKey)
+	{
+		return static_cast<int>(GlyphKey >> 16);
+	}
+
+	FORCEINLINE ImWchar GetCodepoint(uint32 GlyphKey)
+	{
+		return static_cast<ImWchar>(GlyphKey & 0xFFFF);
+	}
+
+	// Copy of settings used to build font atlas (so it can be used outside of the game thread).
+	struct FBuildConfig
+	{
+		TArray<FImGuiFontConfig> Fonts;
+		int32 DynamicGlyphCacheSize = 0;
+		bool bUseDynamicGlyphCache = false;
+		bool bSignedDistanceField = false;
+	};
+
+	FBuildConfig GetBuildConfig(const FImGuiModuleSettings& Settings, const FString& UnavailableMaterial)
+	{
+		FBuildConfig BuildConfig;
+		BuildConfig.Fonts = Settings.GetFonts();
+		BuildConfig.DynamicGlyphCacheSize = Settings.GetDynamicGlyphCacheSize();
+		BuildConfig.bUseDynamicGlyphCache = Settings.UseDynamicGlyphCache();
+
+		// Distance fields are not readable without a material that can render them.
+		BuildConfig.bSignedDistanceField = Settings.UseSignedDistanceFieldFonts();
+		if (BuildConfig.bSignedDistanceField && !Settings.GetFontAtlasMaterial().IsValid())
+		{
+			UE_LOG(LogImGui, Warning, TEXT("Signed distance field fonts require Font Atlas Material. Using bitmap fonts instead."));
+			BuildConfig.bSignedDistanceField = false;
+		}
+		else if (BuildConfig.bSignedDistanceField && Settings.GetFontAtlasMaterial().ToString() == UnavailableMaterial)
+		{
+			UE_LOG(LogImGui, Warning, TEXT("Font Atlas Material '%s' couldn't be loaded. Using bitmap fonts instead."), *UnavailableMaterial);
+			BuildConfig.bSignedDistanceField = false;
+		}
+
+		return BuildConfig;
+	}
+
+	void AddFonts(ImFontAtlas& Atlas, const FBuildConfig& BuildConfig, TArray<TPair<int, const ImWchar*>>& OutDynamicRanges,
+		TArray<FString>& OutFontFiles)
+	{
+		for (const FImGuiFontConfig& FontConfig : BuildConfig.Fonts)
+		{
+			const FString Path = GetFontPath(FontConfig.File);
+
+			int32 DataSize = 0;
+			void* Data = LoadFontData(Path, DataSize);
+			if (!Data)
+			{
+				UE_LOG(LogImGui, Warning, TEXT("Failed to load font file '%s'."), *Path);
+				continue;
+			}
+
+			// If enabled, dynamic glyph cache handles everything outside of the default range.
+			const ImWchar* GlyphRanges = GetGlyphRanges(Atlas, FontConfig.GlyphRanges);
+			const bool bUseDynamicRanges = BuildConfig.bUseDynamicGlyphCache && FontConfig.GlyphRanges != EImGuiGlyphRanges::Default;
+
+			ImFontConfig Config;
+			Config.MergeMode = FontConfig.bMergeWithPrevious && Atlas.Fonts.Size > 0;
+			Config.OversampleH = FontConfig.OversampleH;
+			Config.OversampleV = FontConfig.OversampleV;
+			Config.GlyphRanges = bUseDynamicRanges ? Atlas.GetGlyphRangesDefault() : GlyphRanges;
+			FCStringAnsi::Strncpy(Config.Name, TCHAR_TO_UTF8(*FPaths::GetCleanFilename(Path)), ARRAY_COUNT(Config.Name));
+
+			// Atlas takes ownership of font data.
+			Atlas.AddFontFromMemoryTTF(Data, DataSize, FontConfig.Size, &Config);
+			OutFontFiles.Add(Path);
+
+			if (bUseDynamicRanges)
+			{
+				OutDynamicRanges.Emplace(Atlas.ConfigData.Size - 1, GlyphRanges);
+			}
+		}
+
+		if (Atlas.Fonts.Size == 0)
+		{
+			Atlas.AddFontDefault();
+			OutFontFiles.Add(TEXT("Default"));
+		}
+	}
+
+	FSHAHash GetCacheKey(const ImFontAtlas& Atlas, const FBuildConfig& BuildConfig, const TArray<FString>& FontFiles)
+	{
+		FSHA1 Hash;
+
+		auto Update = [&Hash](const auto& Value)
+		{
+			Hash.Update(reinterpret_cast<const uint8*>(&Value), sizeof(Value));
+		};
+
+		Update(CACHE_VERSION);
+		Update(IMGUI_VERSION_NUM);
+
+		// Font files are identified by their path, size and modification time.
+		for (const FString& File : FontFiles)
+		{
+			Hash.UpdateWithString(*File, File.Len());
+			Update(IFileManager::Get().FileSize(*File));
+			Update(IFileManager::Get().GetTimeStamp(*File));
+		}
+
+		for (const ImFontConfig& Config : Atlas.ConfigData)
+		{
+			Update(Config.FontDataSize);
+			Update(Config.FontNo);
+			Update(Config.SizePixels);
+			Update(Config.OversampleH);
+			Update(Config.OversampleV);
+			Update(Config.PixelSnapH);
+			Update(Config.GlyphExtraSpacing);
+			Update(Config.GlyphOffset);
+			Update(Config.GlyphMinAdvanceX);
+			Update(Config.GlyphMaxAdvanceX);
+			Update(Config.MergeMode);
+			Update(Config.RasterizerMultiply);
+			Update(static_cast<int32>(Atlas.Fonts.find(Config.DstFont) - Atlas.Fonts.begin()));
+
+			for (const ImWchar* Range = Config.GlyphRanges; Range && Range[0] && Range[1]; Range += 2)
+			{
+				Update(Range[0]);
+				Update(Range[1]);
+			}
+			Update(ImWchar{ 0 });
+		}
+
+		for (const ImFontAtlasCustomRect& Rect : Atlas.CustomRects)
+		{
+			Update(Rect.ID);
+			Update(Rect.Width);
+			Update(Rect.Height);
+		}
+
+		Update(Atlas.Flags);
+		Update(BuildConfig.bSignedDistanceField);
+		Update(Atlas.TexDesiredWidth);
+		Update(Atlas.TexGlyphPadding);
+
+		FSHAHash Key;
+		Hash.Final();
+		Hash.GetHash(Key.Hash);
+		return Key;
+	}
+
+	bool LoadFromCache(ImFontAtlas& Atlas, const FSHAHash& Key)
+	{
+		const FString CacheFile = GetCacheFile();
+		if (!FPaths::FileExists(CacheFile))
+		{
+			return false;
+		}
+
+		// Map the file, so we can copy atlas data without intermediate buffers.
+#if ENGINE_COMPATIBILITY_WITH_MAPPED_FILES
+		TUniquePtr<IMappedFileHandle> MappedFile{ FPlatformFileManager::Get().GetPlatformFile().OpenMapped(*CacheFile) };
+		TUniquePtr<IMappedFileRegion> MappedRegion{ MappedFile ? MappedFile->MapRegion(0, MappedFile->GetFileSize()) : nullptr };
+		if (!MappedRegion)
+		{
+			return false;
+		}
+
+		FBufferReader Reader{ const_cast<uint8*>(MappedRegion->GetMappedPtr()), MappedRegion->GetMappedSize(), false };
+#else
+		TArray<uint8> Data;
+		if (!FFileHelper::LoadFileToArray(Data, *CacheFile, FILEREAD_Silent))
+		{
+			return false;
+		}
+
+		FBufferReader Reader{ Data.GetData(), Data.Num(), false };
+#endif
+
+		uint32 Magic = 0, Version = 0;
+		FSHAHash CachedKey;
+		Reader << Magic << Version << CachedKey;
+		if (Reader.IsError() || Magic != CACHE_MAGIC || Version != CACHE_VERSION || CachedKey != Key)
+		{
+			return false;
+		}
+
+		if (!SerializeBuildData(Reader, Atlas))
+		{
+			UE_LOG(LogImGui, Warning, TEXT("Font atlas cache '%s' is corrupted. Rebuilding font atlas."), *CacheFile);
+
+			// Revert to a state in which atlas can be built.
+			Atlas.ClearTexData();
+			for (ImFont* Font : Atlas.Fonts)
+			{
+				Font->ClearOutputData();
+				Font->ConfigData = nullptr;
+				Font->ConfigDataCount = 0;
+			}
+			return false;
+		}
+
+		// Glyphs are copied directly, so lookup tables need to be built explicitly (build finish only rebuilds tables
+		// marked as dirty). It also needs to happen before placeholders are added, as they only fill missing glyphs.
+		for (ImFont* Font : Atlas.Fonts)
+		{
+			Font->BuildLookupTable();
+		}
+
+		ImFontAtlasBuildFinish(&Atlas);
+		return true;
+	}
+
+	void SaveToCache(ImFontAtlas& Atlas, const FSHAHash& Key)
+	{
+		// Write to a temporary file and replace the old cache only after successful write.
+		const FString CacheFile = GetCacheFile();
+		const FString TempFile = CacheFile + TEXT(".tmp");
+
+		bool bSaved = false;
+		{
+			TUniquePtr<FArchive> Writer{ IFileManager::Get().CreateFileWriter(*TempFile) };
+			if (Writer)
+			{
+				uint32 Magic = CACHE_MAGIC, Version = CACHE_VERSION;
+				FSHAHash CacheKey = Key;
+				*Writer << Magic << Version << CacheKey;
+				bSaved = SerializeBuildData(*Writer, Atlas) && Writer->Close();
+			}
+		}
+
+		if (!bSaved || !IFileManager::Get().Move(*CacheFile, *TempFile))
+		{
+			UE_LOG(LogImGui, Warning, TEXT("Failed to save font atlas cache '%s'."), *CacheFile);
+			IFileManager::Get().Delete(*TempFile, false, false, true);
+		}
+	}
+
+	// Build font atlas (or load it from cache) and create glyph rasterizer, if needed. It doesn't depend on the game
+	// thread state, so it can be called from any thread.
+	void BuildAtlas(ImFontAtlas& Atlas, TUniquePtr<ImGuiImplementation::FGlyphRasterizer>& OutGlyphRasterizer,
+		const FBuildConfig& BuildConfig)
+	{
+		TArray<TPair<int, const ImWchar*>> DynamicRanges;
+		TArray<FString> FontFiles;
+		AddFonts(Atlas, BuildConfig, DynamicRanges, FontFiles);
+
+		// Reserve atlas region for glyphs rasterised on demand. Atlas needs to be wide enough to fit it, including padding.
+		int RegionRectIndex = INDEX_NONE;
+		if (DynamicRanges.Num() > 0)
+		{
+			const int32 CacheSize = FMath::RoundUpToPowerOfTwo(BuildConfig.DynamicGlyphCacheSize);
+			const int32 RegionSize = CacheSize - Atlas.TexGlyphPadding;
+			RegionRectIndex = Atlas.AddCustomRectRegular(DYNAMIC_GLYPH_CACHE_RECT_ID, RegionSize, RegionSize);
+			Atlas.TexDesiredWidth = FMath::Max(Atlas.TexDesiredWidth, CacheSize);
+		}
+
+		// Default rectangles are registered during build but we need them to be part of the cache key.
+		ImFontAtlasBuildRegisterDefaultCustomRects(&Atlas);
+
+		const FSHAHash CacheKey = GetCacheKey(Atlas, BuildConfig, FontFiles);
+		if (!LoadFromCache(Atlas, CacheKey))
+		{
+			ImGuiImplementation::BuildFontAtlas(Atlas, BuildConfig.bSignedDistanceField);
+			SaveToCache(Atlas, CacheKey);
+		}
+
+		// Add placeholders for glyphs that weren't baked, so they can be rasterised on the first use.
+		if (RegionRectIndex != INDEX_NONE)
+		{
+			OutGlyphRasterizer = MakeUnique<ImGuiImplementation::FGlyphRasterizer>(Atlas, RegionRectIndex, BuildConfig.bSignedDistanceField);
+			for (const auto& Ranges : DynamicRanges)
+			{
+				OutGlyphRasterizer->AddPlaceholders(Ranges.Key, Ranges.Value);
+			}
+		}
+	}
+}
+
+FImGuiFontAtlas::FAtlasData::~FAtlasData()
+{
+}
+
+FImGuiFontAtlas::FImGuiFontAtlas(const FImGuiModuleSettings& InSettings)
+	: Settings(InSettings)
+{
+}
+
+FImGuiFontAtlas::~FImGuiFontAtlas()
+{
+	// Make sure that the build task is not running code from this module when it is unloaded.
+	if (PendingBuildTask.IsValid())
+	{
+		FTaskGraphInterface::Get().WaitUntilTaskCompletes(PendingBuildTask);
+	}
+}
+
+TSharedRef<ImFontAtlas> FImGuiFontAtlas::GetShared()
+{
+	Get();
+	return TSharedRef<ImFontAtlas>(Current.ToSharedRef(), &Current->Atlas);
+}
+
+void FImGuiFontAtlas::RequestRebuild()
+{
+	// Nothing to do, if atlas wasn't yet built as the first build will use the latest settings.
+	if (Current.IsValid())
+	{
+		bRebuildRequested = true;
+	}
+}
+
+void FImGuiFontAtlas::SetUnavailableMaterial(const FString& MaterialPath)
+{
+	if (UnavailableMaterial != MaterialPath)
+	{
+		UnavailableMaterial = MaterialPath;
+
+		// Distance fields rendered without material are blurred shapes, so we rebuild the atlas if it needs to switch
+		// between distance fields and coverage.
+		if (Current.IsValid() && Current->bSignedDistanceField != CanUseSignedDistanceField())
+		{
+			RequestRebuild();
+		}
+	}
+}
+
+bool FImGuiFontAtlas::CanUseSignedDistanceField() const
+{
+	return Settings.UseSignedDistanceFieldFonts() && Settings.GetFontAtlasMaterial().IsValid()
+		&& Settings.GetFontAtlasMaterial().ToString() != UnavailableMaterial;
+}
+
+bool FImGuiFontAtlas::IsSignedDistanceField(const ImFontAtlas& Atlas) const
+{
+	if (Current.IsValid() && &Current->Atlas == &Atlas)
+	{
+		return Current->bSignedDistanceField;
+	}
+
+	for (const FRetiredAtlas& Retired : RetiredAtlases)
+	{
+		if (&Retired.Data->Atlas == &Atlas)
+		{
+			return Retired.Data->bSignedDistanceField;
+		}
+	}
+
+	return false;
+}
+
+void FImGuiFontAtlas::RequestGlyphs(const ImFontAtlas& SourceAtlas, const ImDrawData& DrawData)
+{
+	// Ignore requests from contexts that still use an old atlas.
+	if (!Current.IsValid() || &Current->Atlas != &SourceAtlas)
+	{
+		return;
+	}
+
+	const TUniquePtr<ImGuiImplementation::FGlyphRasterizer>& GlyphRasterizer = Current->GlyphRasterizer;
+	if (!GlyphRasterizer || GlyphRasterizer->GetNumPlaceholders() == 0)
+	{
+		return;
+	}
+
+	// Placeholders can only be drawn with the atlas texture, so other commands are skipped. All corners of a placeholder
+	// quad have the same texture coordinates, so it is enough to check one vertex of every triangle.
+	for (int ListIndex = 0; ListIndex < DrawData.CmdListsCount; ListIndex++)
+	{
+		const ImDrawList& DrawList = *DrawData.CmdLists[ListIndex];
+		for (const ImDrawCmd& DrawCmd : DrawList.CmdBuffer)
+		{
+			if (DrawCmd.UserCallback || DrawCmd.TextureId != SourceAtlas.TexID)
+			{
+				continue;
+			}
+
+			const ImDrawIdx* Indices = DrawList.IdxBuffer.Data + DrawCmd.IdxOffset;
+			const ImDrawVert* Vertices = DrawList.VtxBuffer.Data + DrawCmd.VtxOffset;
+			for (unsigned int Index = 0; Index < DrawCmd.ElemCount; Index += 3)
+			{
+				int ConfigIndex;
+				ImWchar Codepoint;
+				if (ImGuiImplementation::FGlyphRasterizer::DecodePlaceholder(Vertices[Indices[Index]].uv, ConfigIndex, Codepoint))
+				{
+					RequestedGlyphs.Add(GetGlyphKey(ConfigIndex, Codepoint));
+				}
+			}
+		}
+	}
+}
+
+void FImGuiFontAtlas::Update()
+{
+	UpdateRebuild();
+	UpdateGlyphs();
+}
+
+bool FImGuiFontAtlas::ConsumeDirtyArea(FIntRect& OutArea)
+{
+	if (bHasDirtyArea)
+	{
+		OutArea = DirtyArea;
+		bHasDirtyArea = false;
+		return true;
+	}
+	return false;
+}
+
+void FImGuiFontAtlas::ReleaseUnusedAtlases(TArray<ImTextureID>& OutTextures)
+{
+	for (int32 Index = RetiredAtlases.Num() - 1; Index >= 0; Index--)
+	{
+		FRetiredAtlas& Retired = RetiredAtlases[Index];
+
+		// Wait until atlas is no longer used by any context or draw data.
+		if (!Retired.Data.IsUnique())
+		{
+			continue;
+		}
+
+		// Render thread may still draw its texture, so we need to wait for it to catch up, before releasing.
+		if (!Retired.bIsReleasing)
+		{
+			Retired.Fence.BeginFence();
+			Retired.bIsReleasing = true;
+		}
+		else if (Retired.Fence.IsFenceComplete())
+		{
+			if (Retired.Data->Atlas.TexID)
+			{
+				OutTextures.Add(Retired.Data->Atlas.TexID);
+			}
+			RetiredAtlases.RemoveAtSwap(Index);
+		}
+	}
+}
+
+void FImGuiFontAtlas::Build()
+{
+	// The first build needs to be synchronous, as atlas is required to create contexts.
+	const FBuildConfig BuildConfig = GetBuildConfig(Settings, UnavailableMaterial);
+	Current = MakeShared<FAtlasData>();
+	Current->bSignedDistanceField = BuildConfig.bSignedDistanceField;
+	BuildAtlas(Current->Atlas, Current->GlyphRasterizer, BuildConfig);
+}
+
+void FImGuiFontAtlas::UpdateRebuild()
+{
+	// Swap atlases when build is complete. Contexts will switch to the new atlas at the beginning of their next frame.
+	if (PendingBuildTask.IsValid() && PendingBuildTask->IsComplete())
+	{
+		RetiredAtlases.Add({ MoveTemp(Current) });
+		Current = MoveTemp(PendingAtlas);
+		PendingBuildTask = nullptr;
+		Generation++;
+
+		// Requests and updates for the old atlas are no longer relevant.
+		RequestedGlyphs.Empty();
+		bHasDirtyArea = false;
+	}
+
+	// Start a new build with a copy of the current settings. If build is already in progress, wait until it is complete.
+	if (bRebuildRequested && !PendingBuildTask.IsValid())
+	{
+		bRebuildRequested = false;
+
+		FBuildConfig BuildConfig = GetBuildConfig(Settings, UnavailableMaterial);
+		PendingAtlas = MakeShared<FAtlasData>();
+		PendingAtlas->bSignedDistanceField = BuildConfig.bSignedDistanceField;
+		PendingBuildTask = FFunctionGraphTask::CreateAndDispatchWhenReady(
+			[AtlasData = PendingAtlas, BuildConfig = MoveTemp(BuildConfig)]()
+			{
+				BuildAtlas(AtlasData->Atlas, AtlasData->GlyphRasterizer, BuildConfig);
+			}, TStatId(), nullptr, ENamedThreads::AnyThread);
+	}
+}
+
+void FImGuiFontAtlas::UpdateGlyphs()
+{
+	if (!Current.IsValid() || !Current->GlyphRasterizer || RequestedGlyphs.Num() == 0)
+	{
+		return;
+	}
+
+	ImGuiImplementation::FGlyphRasterizer& GlyphRasterizer = *Current->GlyphRasterizer;
+
+	int32 RasterizedGlyphs = 0;
+	for (auto It = RequestedGlyphs.CreateIterator(); It && RasterizedGlyphs < MAX_GLYPHS_PER_UPDATE; ++It)
+	{
+		FIntRect Area;
+		if (GlyphRasterizer.Rasterize(GetConfigIndex(*It), GetCodepoint(*It), Area))
+		{
+			UpdateRGBA32(Area);
+			MarkDirty(Area);
+			RasterizedGlyphs++;
+		}
+
+		It.RemoveCurrent();
+	}
+}
+
+void FImGuiFontAtlas::UpdateRGBA32(const FIntRect& Area)
+{
+	// Keep RGBA data in sync, if it was requested by texture manager.
+	ImFontAtlas& Atlas = Current->Atlas;
+	if (Atlas.TexPixelsRGBA32)
+	{
+		for (int32 Y = Area.Min.Y; Y < Area.Max.Y; Y++)
+		{
+			const unsigned char* Src = Atlas.TexPixelsAlpha8 + Y * Atlas.TexWidth + Area.Min.X;
+			unsigned int* Dst = Atlas.TexPixelsRGBA32 + Y * Atlas.TexWidth + Area.Min.X;
+			for (int32 X = Area.Min.X; X < Area.Max.X; X++)
+			{
+				*Dst++ = IM_COL32(255, 255, 255, static_cast<unsigned int>(*Src++));
+			}
+		}
+	}
+}
+
+void FImGuiFontAtlas::MarkDirty(const FIntRect& Area)
+{
+	if (bHasDirtyArea)
+	{
+		DirtyArea.Min = DirtyArea.Min.ComponentMin(Area.Min);
+		DirtyArea.Max = DirtyArea.Max.ComponentMax(Area.Max);
+	}
+	else
+	{
+		DirtyArea = Area;
+		bHasDirtyArea = true;
+	}
+}
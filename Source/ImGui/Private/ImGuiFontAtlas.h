@@ -0,0 +1,141 @@
+// Distributed under the MIT License (MIT) (see accompanying LICENSE file)
+
+#pragma once
+
+#include <Async/TaskGraphInterfaces.h>
+#include <RenderingThread.h>
+
+#include <imgui.h>
+
+
+class FImGuiModuleSettings;
+
+namespace ImGuiImplementation
+{
+	class FGlyphRasterizer;
+}
+
+// Font atlas shared by all ImGui contexts. It is built on the first use from fonts defined in settings. If enabled,
+// it maintains a dynamic glyph cache, which rasterises on demand glyphs that were not baked during build.
+//
+// Baked atlas is cached on disk together with a hash of its configuration, so next time it can be loaded instead of
+// being built, as long as configuration and font files don't change.
+//
+// Glyphs in dynamic ranges are initially represented by invisible placeholders with correct metrics. When they are
+// found in context draw data, they are queued and rasterised between frames, so they are visible from the next frame.
+//
+// When fonts change, a new atlas is built on a worker thread, while contexts keep using the current one. After build
+// completes, the new atlas becomes current and contexts switch to it at the beginning of their next frame. The old atlas
+// is shared with contexts and their draw data, and it is released when none of them uses it anymore.
+class FImGuiFontAtlas
+{
+public:
+
+	FImGuiFontAtlas(const FImGuiModuleSettings& InSettings);
+	~FImGuiFontAtlas();
+
+	FImGuiFontAtlas(const FImGuiFontAtlas&) = delete;
+	FImGuiFontAtlas& operator=(const FImGuiFontAtlas&) = delete;
+
+	FImGuiFontAtlas(FImGuiFontAtlas&&) = delete;
+	FImGuiFontAtlas& operator=(FImGuiFontAtlas&&) = delete;
+
+	// Get the current font atlas. Atlas is built during the first call.
+	ImFontAtlas& Get()
+	{
+		if (UNLIKELY(!Current.IsValid()))
+		{
+			Build();
+		}
+		return Current->Atlas;
+	}
+
+	// Get a shared reference to the current font atlas. It keeps atlas alive after it is replaced by a rebuilt one.
+	TSharedRef<ImFontAtlas> GetShared();
+
+	// Get the number of times atlas was replaced. Can be used to create unique texture names.
+	uint32 GetGeneration() const { return Generation; }
+
+	// Request to rebuild the atlas with the latest settings. Build runs asynchronously and the current atlas stays
+	// valid until it is complete.
+	void RequestRebuild();
+
+	// Set font atlas material that couldn't be loaded. Signed distance fields are readable only with a material that can
+	// render them, so atlases built while that material is set use coverage instead. If that changes the kind of the
+	// current atlas, it is rebuilt.
+	// @param MaterialPath - Path of the material that failed to load or empty string if material was loaded
+	void SetUnavailableMaterial(const FString& MaterialPath);
+
+	// Whether glyphs in the atlas are baked as signed distance fields.
+	// @param Atlas - The current atlas or an old one that is still used by contexts
+	bool IsSignedDistanceField(const ImFontAtlas& Atlas) const;
+
+	// Find placeholders in draw data and request rasterisation of their glyphs. While there are placeholders that were
+	// not rasterised, this scans triangles drawn with the atlas texture every frame, so its cost grows with the amount
+	// of text. It stops once all placeholders are rasterised or the glyph cache is full.
+	// @param SourceAtlas - Atlas used by a context that generated draw data (ignored if it is not the current one)
+	// @param DrawData - Draw data generated by a context using this atlas
+	void RequestGlyphs(const ImFontAtlas& SourceAtlas, const ImDrawData& DrawData);
+
+	// Swap in a rebuilt atlas, if ready, and rasterise requested glyphs. Should be called between frames, after
+	// contexts generated their draw data.
+	void Update();
+
+	// Get the atlas area modified since the last call and reset it.
+	// @param OutArea - Area modified since the last call
+	// @returns True, if atlas was modified since the last call
+	bool ConsumeDirtyArea(FIntRect& OutArea);
+
+	// Release old atlases that are no longer used by contexts or the render thread.
+	// @param OutTextures - Array to which we add textures of released atlases, so they can be released as well
+	void ReleaseUnusedAtlases(TArray<ImTextureID>& OutTextures);
+
+private:
+
+	struct FAtlasData
+	{
+		~FAtlasData();
+
+		ImFontAtlas Atlas;
+		TUniquePtr<ImGuiImplementation::FGlyphRasterizer> GlyphRasterizer;
+		bool bSignedDistanceField = false;
+	};
+
+	struct FRetiredAtlas
+	{
+		TSharedPtr<FAtlasData> Data;
+		FRenderCommandFence Fence;
+		bool bIsReleasing = false;
+	};
+
+	void Build();
+
+	// Whether settings request signed distance fields and their material is available.
+	bool CanUseSignedDistanceField() const;
+
+	void UpdateRebuild();
+	void UpdateGlyphs();
+
+	void UpdateRGBA32(const FIntRect& Area);
+
+	void MarkDirty(const FIntRect& Area);
+
+	const FImGuiModuleSettings& Settings;
+
+	TSharedPtr<FAtlasData> Current;
+	uint32 Generation = 0;
+
+	TSharedPtr<FAtlasData> PendingAtlas;
+	FGraphEventRef PendingBuildTask;
+	bool bRebuildRequested = false;
+
+	TArray<FRetiredAtlas> RetiredAtlases;
+
+	// Path of the font atlas material that couldn't be loaded.
+	FString UnavailableMaterial;
+
+	TSet<uint32> RequestedGlyphs;
+
+	FIntRect DirtyArea;
+	bool bHasDirtyArea = false;
+};
@@ -15,13 +15,19 @@
 #define IMGUI_DISABLE_WIN32_DEFAULT_IME_FUNCTIONS
 #endif // PLATFORM_XBOXONE
 
+// ImGui context pointer. All contexts are used on the game thread, so we keep the current context per thread. That way
+// code running on other threads (like background font atlas builds) never sees a context and allocations made there
+// cannot touch allocation counters of a context that the game thread might be using or destroying at the same time.
+thread_local ImGuiContext* GImGuiContextPtr = nullptr;
+
 #if WITH_EDITOR
-// Global ImGui context pointer.
-ImGuiContext* GImGuiContextPtr = nullptr;
-// Handle to the global ImGui context pointer.
-ImGuiContext** GImGuiContextPtrHandle = &GImGuiContextPtr;
+// Handle to the ImGui context pointer. Like the pointer itself, it is kept per thread, so redirection set on the game
+// thread doesn't expose its context to other threads.
+thread_local ImGuiContext** GImGuiContextPtrHandle = &GImGuiContextPtr;
 // Get the global ImGui context pointer (GImGui) indirectly to allow redirections in obsolete modules.
 #define GImGui (*GImGuiContextPtrHandle)
+#else
+#define GImGui GImGuiContextPtr
 #endif // WITH_EDITOR
 
 #if PLATFORM_WINDOWS
@@ -38,6 +44,9 @@ ImGuiContext** GImGuiContextPtrHandle = &GImGuiContextPtr;
 #endif // PLATFORM_WINDOWS
 
 #include "ImGuiInteroperability.h"
+#include "Utilities/ScopeGuards.h"
+
+#include <Async/ParallelFor.h>
 
 
 namespace ImGuiImplementation
@@ -53,4 +62,702 @@ namespace ImGuiImplementation
 		GImGuiContextPtrHandle = Handle;
 	}
 #endif // WITH_EDITOR
+
+	//====================================================================================================
+	// Font Atlas Build
+	//====================================================================================================
+
+	namespace
+	{
+		// Maximum number of glyphs processed by a single build task. Sources are split into tasks of this size, so big
+		// ranges (like CJK) can be processed by multiple threads.
+		constexpr int GLYPHS_PER_BUILD_TASK = 256;
+
+		// Range of glyphs from a single source font.
+		struct FGlyphsTask
+		{
+			int SourceIndex;
+			int FirstGlyph;
+			int NumGlyphs;
+		};
+
+		constexpr unsigned char SIGNED_DISTANCE_FIELD_ON_EDGE_VALUE = 128;
+		constexpr float SIGNED_DISTANCE_FIELD_PIXEL_DIST_SCALE = SIGNED_DISTANCE_FIELD_ON_EDGE_VALUE / static_cast<float>(SIGNED_DISTANCE_FIELD_PADDING);
+
+		// Set size of a rectangle needed to pack a signed distance field glyph (including atlas padding).
+		void GatherSignedDistanceFieldRect(const stbtt_fontinfo& FontInfo, int GlyphIndex, float Scale, int Padding, stbrp_rect& OutRect)
+		{
+			int X0, Y0, X1, Y1;
+			stbtt_GetGlyphBitmapBox(&FontInfo, GlyphIndex, Scale, Scale, &X0, &Y0, &X1, &Y1);
+
+			// Empty glyphs have no field (but we still need to pack them to get their advance).
+			const bool bIsEmpty = (X0 == X1 || Y0 == Y1);
+			OutRect.w = bIsEmpty ? 0 : (stbrp_coord)(X1 - X0 + 2 * SIGNED_DISTANCE_FIELD_PADDING + Padding);
+			OutRect.h = bIsEmpty ? 0 : (stbrp_coord)(Y1 - Y0 + 2 * SIGNED_DISTANCE_FIELD_PADDING + Padding);
+		}
+
+		// Render a signed distance field glyph into a packed rectangle. This is an equivalent of
+		// stbtt_PackFontRangesRenderIntoRects for a single glyph.
+		void RenderSignedDistanceFieldRect(const stbtt_fontinfo& FontInfo, int GlyphIndex, float Scale, int Padding,
+			unsigned char* Pixels, int Stride, stbrp_rect& Rect, stbtt_packedchar& OutChar)
+		{
+			int Advance, LeftSideBearing;
+			stbtt_GetGlyphHMetrics(&FontInfo, GlyphIndex, &Advance, &LeftSideBearing);
+			OutChar.xadvance = Scale * Advance;
+
+			if (!Rect.was_packed || Rect.w == 0 || Rect.h == 0)
+			{
+				return;
+			}
+
+			// Pad on left and top.
+			Rect.x += Padding;
+			Rect.y += Padding;
+			Rect.w -= Padding;
+			Rect.h -= Padding;
+
+			int Width = 0, Height = 0, OffsetX = 0, OffsetY = 0;
+			unsigned char* Field = stbtt_GetGlyphSDF(&FontInfo, Scale, GlyphIndex, SIGNED_DISTANCE_FIELD_PADDING,
+				SIGNED_DISTANCE_FIELD_ON_EDGE_VALUE, SIGNED_DISTANCE_FIELD_PIXEL_DIST_SCALE, &Width, &Height, &OffsetX, &OffsetY);
+			if (!Field)
+			{
+				return;
+			}
+
+			Width = FMath::Min<int>(Width, Rect.w);
+			Height = FMath::Min<int>(Height, Rect.h);
+			for (int Row = 0; Row < Height; Row++)
+			{
+				FMemory::Memcpy(Pixels + Rect.x + (Rect.y + Row) * Stride, Field + Row * Width, Width);
+			}
+			stbtt_FreeSDF(Field, FontInfo.userdata);
+
+			OutChar.x0 = (stbtt_int16)Rect.x;
+			OutChar.y0 = (stbtt_int16)Rect.y;
+			OutChar.x1 = (stbtt_int16)(Rect.x + Width);
+			OutChar.y1 = (stbtt_int16)(Rect.y + Height);
+			OutChar.xoff = (float)OffsetX;
+			OutChar.yoff = (float)OffsetY;
+			OutChar.xoff2 = (float)(OffsetX + Width);
+			OutChar.yoff2 = (float)(OffsetY + Height);
+		}
+
+		void CreateGlyphsTasks(const TArray<ImFontBuildSrcData>& Sources, TArray<FGlyphsTask>& OutTasks)
+		{
+			for (int SourceIndex = 0; SourceIndex < Sources.Num(); SourceIndex++)
+			{
+				const int GlyphsCount = Sources[SourceIndex].GlyphsCount;
+				for (int FirstGlyph = 0; FirstGlyph < GlyphsCount; FirstGlyph += GLYPHS_PER_BUILD_TASK)
+				{
+					OutTasks.Add({ SourceIndex, FirstGlyph, FMath::Min(GLYPHS_PER_BUILD_TASK, GlyphsCount - FirstGlyph) });
+				}
+			}
+		}
+	}
+
+	// Follows ImFontAtlasBuildWithStbTruetype step by step, so keep it in sync when updating ImGui.
+	static bool BuildFontAtlasInternal(ImFontAtlas& Atlas, bool bSignedDistanceField)
+	{
+		IM_ASSERT(Atlas.ConfigData.Size > 0);
+
+		ImFontAtlasBuildRegisterDefaultCustomRects(&Atlas);
+
+		// Clear atlas.
+		Atlas.TexID = (ImTextureID)NULL;
+		Atlas.TexWidth = Atlas.TexHeight = 0;
+		Atlas.TexUvScale = ImVec2(0.0f, 0.0f);
+		Atlas.TexUvWhitePixel = ImVec2(0.0f, 0.0f);
+		Atlas.ClearTexData();
+
+		// Temporary storage for building (zeroed state is valid for ImGui containers).
+		TArray<ImFontBuildSrcData> Sources;
+		TArray<ImFontBuildDstData> Destinations;
+		Sources.SetNumZeroed(Atlas.ConfigData.Size);
+		Destinations.SetNumZeroed(Atlas.Fonts.Size);
+
+		// 1. Initialize font loading structure, check font data validity.
+		for (int SourceIndex = 0; SourceIndex < Sources.Num(); SourceIndex++)
+		{
+			ImFontBuildSrcData& Source = Sources[SourceIndex];
+			ImFontConfig& Config = Atlas.ConfigData[SourceIndex];
+			IM_ASSERT(Config.DstFont && (!Config.DstFont->IsLoaded() || Config.DstFont->ContainerAtlas == &Atlas));
+
+			Source.DstIndex = (int)(Atlas.Fonts.find(Config.DstFont) - Atlas.Fonts.begin());
+			IM_ASSERT(Source.DstIndex < Atlas.Fonts.Size);
+			if (Source.DstIndex >= Atlas.Fonts.Size)
+			{
+				return false;
+			}
+
+			const int FontOffset = stbtt_GetFontOffsetForIndex((unsigned char*)Config.FontData, Config.FontNo);
+			IM_ASSERT(FontOffset >= 0 && "FontData is incorrect, or FontNo cannot be found.");
+			if (!stbtt_InitFont(&Source.FontInfo, (unsigned char*)Config.FontData, FontOffset))
+			{
+				return false;
+			}
+
+			ImFontBuildDstData& Destination = Destinations[Source.DstIndex];
+			Source.SrcRanges = Config.GlyphRanges ? Config.GlyphRanges : Atlas.GetGlyphRangesDefault();
+			for (const ImWchar* Range = Source.SrcRanges; Range[0] && Range[1]; Range += 2)
+			{
+				Source.GlyphsHighest = ImMax(Source.GlyphsHighest, (int)Range[1]);
+			}
+			Destination.SrcCount++;
+			Destination.GlyphsHighest = ImMax(Destination.GlyphsHighest, Source.GlyphsHighest);
+		}
+
+		// 2. Find codepoints available in fonts. Lookups are independent for each source, but resolving overlaps
+		// between sources merged into the same font depends on order, so it is done serially afterwards.
+		TArray<ImBoolVector> AvailableGlyphs;
+		AvailableGlyphs.SetNum(Sources.Num());
+		ParallelFor(Sources.Num(), [&](int32 SourceIndex)
+		{
+			ImFontBuildSrcData& Source = Sources[SourceIndex];
+			ImBoolVector& Available = AvailableGlyphs[SourceIndex];
+			Available.Resize(Source.GlyphsHighest + 1);
+			for (const ImWchar* Range = Source.SrcRanges; Range[0] && Range[1]; Range += 2)
+			{
+				for (unsigned int Codepoint = Range[0]; Codepoint <= Range[1]; Codepoint++)
+				{
+					if (stbtt_FindGlyphIndex(&Source.FontInfo, Codepoint))
+					{
+						Available.SetBit(Codepoint, true);
+					}
+				}
+			}
+		});
+
+		int TotalGlyphsCount = 0;
+		for (int SourceIndex = 0; SourceIndex < Sources.Num(); SourceIndex++)
+		{
+			ImFontBuildSrcData& Source = Sources[SourceIndex];
+			ImFontBuildDstData& Destination = Destinations[Source.DstIndex];
+			const ImBoolVector& Available = AvailableGlyphs[SourceIndex];
+			Source.GlyphsSet.Resize(Source.GlyphsHighest + 1);
+			if (Destination.GlyphsSet.Storage.empty())
+			{
+				Destination.GlyphsSet.Resize(Destination.GlyphsHighest + 1);
+			}
+
+			for (const ImWchar* Range = Source.SrcRanges; Range[0] && Range[1]; Range += 2)
+			{
+				for (unsigned int Codepoint = Range[0]; Codepoint <= Range[1]; Codepoint++)
+				{
+					if (Destination.GlyphsSet.GetBit(Codepoint) || !Available.GetBit(Codepoint))
+					{
+						continue;
+					}
+
+					Source.GlyphsCount++;
+					Destination.GlyphsCount++;
+					Source.GlyphsSet.SetBit(Codepoint, true);
+					Destination.GlyphsSet.SetBit(Codepoint, true);
+					TotalGlyphsCount++;
+				}
+			}
+		}
+		AvailableGlyphs.Empty();
+
+		// 3. Unpack bit maps into flat lists of requested, available and not overlapping codepoints.
+		for (ImFontBuildSrcData& Source : Sources)
+		{
+			Source.GlyphsList.reserve(Source.GlyphsCount);
+			UnpackBoolVectorToFlatIndexList(&Source.GlyphsSet, &Source.GlyphsList);
+			Source.GlyphsSet.Clear();
+			IM_ASSERT(Source.GlyphsList.Size == Source.GlyphsCount);
+		}
+		Destinations.Empty();
+
+		// Allocate packing data and flag packed characters as non-packed (x0=y0=x1=y1=0).
+		TArray<stbrp_rect> Rects;
+		TArray<stbtt_packedchar> PackedChars;
+		Rects.SetNumZeroed(TotalGlyphsCount);
+		PackedChars.SetNumZeroed(TotalGlyphsCount);
+
+		int RectsOffset = 0;
+		for (int SourceIndex = 0; SourceIndex < Sources.Num(); SourceIndex++)
+		{
+			ImFontBuildSrcData& Source = Sources[SourceIndex];
+			if (Source.GlyphsCount == 0)
+			{
+				continue;
+			}
+
+			Source.Rects = &Rects[RectsOffset];
+			Source.PackedChars = &PackedChars[RectsOffset];
+			RectsOffset += Source.GlyphsCount;
+
+			const ImFontConfig& Config = Atlas.ConfigData[SourceIndex];
+			Source.PackRange.font_size = Config.SizePixels;
+			Source.PackRange.first_unicode_codepoint_in_range = 0;
+			Source.PackRange.array_of_unicode_codepoints = Source.GlyphsList.Data;
+			Source.PackRange.num_chars = Source.GlyphsList.Size;
+			Source.PackRange.chardata_for_range = Source.PackedChars;
+			Source.PackRange.h_oversample = (unsigned char)Config.OversampleH;
+			Source.PackRange.v_oversample = (unsigned char)Config.OversampleV;
+		}
+
+		TArray<FGlyphsTask> Tasks;
+		CreateGlyphsTasks(Sources, Tasks);
+
+		// 4. Gather glyph sizes, so we can pack them in our virtual canvas.
+		ParallelFor(Tasks.Num(), [&](int32 TaskIndex)
+		{
+			const FGlyphsTask& Task = Tasks[TaskIndex];
+			const ImFontConfig& Config = Atlas.ConfigData[Task.SourceIndex];
+			ImFontBuildSrcData& Source = Sources[Task.SourceIndex];
+
+			const float Scale = (Config.SizePixels > 0)
+				? stbtt_ScaleForPixelHeight(&Source.FontInfo, Config.SizePixels)
+				: stbtt_ScaleForMappingEmToPixels(&Source.FontInfo, -Config.SizePixels);
+			const int Padding = Atlas.TexGlyphPadding;
+			for (int GlyphIndex = Task.FirstGlyph; GlyphIndex < Task.FirstGlyph + Task.NumGlyphs; GlyphIndex++)
+			{
+				const int GlyphIndexInFont = stbtt_FindGlyphIndex(&Source.FontInfo, Source.GlyphsList[GlyphIndex]);
+				IM_ASSERT(GlyphIndexInFont != 0);
+				if (bSignedDistanceField)
+				{
+					GatherSignedDistanceFieldRect(Source.FontInfo, GlyphIndexInFont, Scale, Padding, Source.Rects[GlyphIndex]);
+					continue;
+				}
+
+				int X0, Y0, X1, Y1;
+				stbtt_GetGlyphBitmapBoxSubpixel(&Source.FontInfo, GlyphIndexInFont, Scale * Config.OversampleH,
+					Scale * Config.OversampleV, 0, 0, &X0, &Y0, &X1, &Y1);
+				Source.Rects[GlyphIndex].w = (stbrp_coord)(X1 - X0 + Padding + Config.OversampleH - 1);
+				Source.Rects[GlyphIndex].h = (stbrp_coord)(Y1 - Y0 + Padding + Config.OversampleV - 1);
+			}
+		});
+
+		int TotalSurface = 0;
+		for (const stbrp_rect& Rect : Rects)
+		{
+			TotalSurface += Rect.w * Rect.h;
+		}
+
+		// Select width for the skyline algorithm (same heuristic as in ImGui).
+		const int SurfaceSqrt = (int)ImSqrt((float)TotalSurface) + 1;
+		Atlas.TexHeight = 0;
+		if (Atlas.TexDesiredWidth > 0)
+		{
+			Atlas.TexWidth = Atlas.TexDesiredWidth;
+		}
+		else
+		{
+			Atlas.TexWidth = (SurfaceSqrt >= 4096 * 0.7f) ? 4096 : (SurfaceSqrt >= 2048 * 0.7f) ? 2048 : (SurfaceSqrt >= 1024 * 0.7f) ? 1024 : 512;
+		}
+
+		// 5. Start packing. Custom rectangles are packed first, so they are in the upper-left corner of the texture.
+		const int TEX_HEIGHT_MAX = 1024 * 32;
+		stbtt_pack_context PackContext = {};
+		stbtt_PackBegin(&PackContext, NULL, Atlas.TexWidth, TEX_HEIGHT_MAX, 0, Atlas.TexGlyphPadding, NULL);
+		ImFontAtlasBuildPackCustomRects(&Atlas, PackContext.pack_info);
+
+		// 6. Pack each source font in order. This is the only step where order matters for the result.
+		for (ImFontBuildSrcData& Source : Sources)
+		{
+			if (Source.GlyphsCount == 0)
+			{
+				continue;
+			}
+
+			stbrp_pack_rects((stbrp_context*)PackContext.pack_info, Source.Rects, Source.GlyphsCount);
+
+			for (int GlyphIndex = 0; GlyphIndex < Source.GlyphsCount; GlyphIndex++)
+			{
+				if (Source.Rects[GlyphIndex].was_packed)
+				{
+					Atlas.TexHeight = ImMax(Atlas.TexHeight, Source.Rects[GlyphIndex].y + Source.Rects[GlyphIndex].h);
+				}
+			}
+		}
+
+		// 7. Allocate texture.
+		Atlas.TexHeight = (Atlas.Flags & ImFontAtlasFlags_NoPowerOfTwoHeight) ? (Atlas.TexHeight + 1) : ImUpperPowerOfTwo(Atlas.TexHeight);
+		Atlas.TexUvScale = ImVec2(1.0f / Atlas.TexWidth, 1.0f / Atlas.TexHeight);
+		Atlas.TexPixelsAlpha8 = (unsigned char*)IM_ALLOC(Atlas.TexWidth * Atlas.TexHeight);
+		memset(Atlas.TexPixelsAlpha8, 0, Atlas.TexWidth * Atlas.TexHeight);
+		PackContext.pixels = Atlas.TexPixelsAlpha8;
+		PackContext.height = Atlas.TexHeight;
+
+		// 8. Rasterise glyphs. Packed rectangles don't overlap, so tasks can write to the texture in parallel. Each task
+		// needs its own copy of the pack context because rendering modifies its oversampling.
+		ParallelFor(Tasks.Num(), [&](int32 TaskIndex)
+		{
+			const FGlyphsTask& Task = Tasks[TaskIndex];
+			const ImFontConfig& Config = Atlas.ConfigData[Task.SourceIndex];
+			ImFontBuildSrcData& Source = Sources[Task.SourceIndex];
+
+			if (bSignedDistanceField)
+			{
+				const float Scale = (Config.SizePixels > 0)
+					? stbtt_ScaleForPixelHeight(&Source.FontInfo, Config.SizePixels)
+					: stbtt_ScaleForMappingEmToPixels(&Source.FontInfo, -Config.SizePixels);
+				for (int GlyphIndex = Task.FirstGlyph; GlyphIndex < Task.FirstGlyph + Task.NumGlyphs; GlyphIndex++)
+				{
+					const int GlyphIndexInFont = stbtt_FindGlyphIndex(&Source.FontInfo, Source.GlyphsList[GlyphIndex]);
+					RenderSignedDistanceFieldRect(Source.FontInfo, GlyphIndexInFont, Scale, Atlas.TexGlyphPadding,
+						Atlas.TexPixelsAlpha8, Atlas.TexWidth, Source.Rects[GlyphIndex], Source.PackedChars[GlyphIndex]);
+				}
+				return;
+			}
+
+			stbtt_pack_context TaskPackContext = PackContext;
+
+			stbtt_pack_range TaskRange = Source.PackRange;
+			TaskRange.array_of_unicode_codepoints += Task.FirstGlyph;
+			TaskRange.chardata_for_range += Task.FirstGlyph;
+			TaskRange.num_chars = Task.NumGlyphs;
+
+			stbrp_rect* TaskRects = Source.Rects + Task.FirstGlyph;
+			stbtt_PackFontRangesRenderIntoRects(&TaskPackContext, &Source.FontInfo, &TaskRange, 1, TaskRects);
+
+			// Apply multiply operator.
+			if (Config.RasterizerMultiply != 1.0f)
+			{
+				unsigned char MultiplyTable[256];
+				ImFontAtlasBuildMultiplyCalcLookupTable(MultiplyTable, Config.RasterizerMultiply);
+				for (int GlyphIndex = 0; GlyphIndex < Task.NumGlyphs; GlyphIndex++)
+				{
+					const stbrp_rect& Rect = TaskRects[GlyphIndex];
+					if (Rect.was_packed)
+					{
+						ImFontAtlasBuildMultiplyRectAlpha8(MultiplyTable, Atlas.TexPixelsAlpha8, Rect.x, Rect.y, Rect.w, Rect.h, Atlas.TexWidth);
+					}
+				}
+			}
+		});
+
+		// End packing.
+		stbtt_PackEnd(&PackContext);
+		for (ImFontBuildSrcData& Source : Sources)
+		{
+			Source.Rects = NULL;
+		}
+		Rects.Empty();
+
+		// 9. Setup fonts and glyphs for runtime.
+		for (int SourceIndex = 0; SourceIndex < Sources.Num(); SourceIndex++)
+		{
+			ImFontBuildSrcData& Source = Sources[SourceIndex];
+			if (Source.GlyphsCount == 0)
+			{
+				continue;
+			}
+
+			ImFontConfig& Config = Atlas.ConfigData[SourceIndex];
+			ImFont* DstFont = Config.DstFont;
+
+			const float FontScale = stbtt_ScaleForPixelHeight(&Source.FontInfo, Config.SizePixels);
+			int UnscaledAscent, UnscaledDescent, UnscaledLineGap;
+			stbtt_GetFontVMetrics(&Source.FontInfo, &UnscaledAscent, &UnscaledDescent, &UnscaledLineGap);
+
+			const float Ascent = ImFloor(UnscaledAscent * FontScale + ((UnscaledAscent > 0.0f) ? +1 : -1));
+			const float Descent = ImFloor(UnscaledDescent * FontScale + ((UnscaledDescent > 0.0f) ? +1 : -1));
+			ImFontAtlasBuildSetupFont(&Atlas, DstFont, &Config, Ascent, Descent);
+			const float FontOffsetX = Config.GlyphOffset.x;
+			const float FontOffsetY = Config.GlyphOffset.y + IM_ROUND(DstFont->Ascent);
+
+			for (int GlyphIndex = 0; GlyphIndex < Source.GlyphsCount; GlyphIndex++)
+			{
+				const int Codepoint = Source.GlyphsList[GlyphIndex];
+				const stbtt_packedchar& PackedChar = Source.PackedChars[GlyphIndex];
+
+				const float AdvanceXOriginal = PackedChar.xadvance;
+				const float AdvanceX = ImClamp(AdvanceXOriginal, Config.GlyphMinAdvanceX, Config.GlyphMaxAdvanceX);
+				float OffsetX = FontOffsetX;
+				if (AdvanceXOriginal != AdvanceX)
+				{
+					OffsetX += Config.PixelSnapH ? ImFloor((AdvanceX - AdvanceXOriginal) * 0.5f) : (AdvanceX - AdvanceXOriginal) * 0.5f;
+				}
+
+				stbtt_aligned_quad Quad;
+				float DummyX = 0.0f, DummyY = 0.0f;
+				stbtt_GetPackedQuad(Source.PackedChars, Atlas.TexWidth, Atlas.TexHeight, GlyphIndex, &DummyX, &DummyY, &Quad, 0);
+				DstFont->AddGlyph((ImWchar)Codepoint, Quad.x0 + OffsetX, Quad.y0 + FontOffsetY, Quad.x1 + OffsetX,
+					Quad.y1 + FontOffsetY, Quad.s0, Quad.t0, Quad.s1, Quad.t1, AdvanceX);
+			}
+		}
+
+		ImFontAtlasBuildFinish(&Atlas);
+		return true;
+	}
+
+	bool BuildFontAtlas(ImFontAtlas& Atlas, bool bSignedDistanceField)
+	{
+		// Allocations in ImGui update counters in the current context. Other threads don't have a current context, but
+		// on the game thread we need to detach it for the duration of the build, so the atlas memory isn't counted as
+		// allocated by whichever context happens to be current.
+		if (IsInGameThread())
+		{
+			auto ContextSaver = ScopeGuards::MakeStateSaver(GImGui);
+			GImGui = nullptr;
+			return BuildFontAtlasInternal(Atlas, bSignedDistanceField);
+		}
+
+		return BuildFontAtlasInternal(Atlas, bSignedDistanceField);
+	}
+
+	//====================================================================================================
+	// FGlyphRasterizer
+	//====================================================================================================
+
+	struct FGlyphRasterizer::FState
+	{
+		struct FSource
+		{
+			stbtt_fontinfo FontInfo;
+			bool bIsValid = false;
+		};
+
+		TArray<FSource> Sources;
+
+		stbrp_context Packer;
+		TArray<stbrp_node> PackerNodes;
+
+		FIntPoint RegionOffset;
+		int NumPlaceholders = 0;
+		bool bIsFull = false;
+	};
+
+	FGlyphRasterizer::FGlyphRasterizer(ImFontAtlas& InAtlas, int RegionRectIndex, bool bInSignedDistanceField)
+		: Atlas(InAtlas)
+		, State(MakeUnique<FState>())
+		, bSignedDistanceField(bInSignedDistanceField)
+	{
+		checkf(Atlas.IsBuilt(), TEXT("Font atlas needs to be built before glyph rasterizer is created."));
+
+		const ImFontAtlasCustomRect* Region = Atlas.GetCustomRectByIndex(RegionRectIndex);
+		checkf(Region && Region->IsPacked(), TEXT("Glyph rasterizer region %d is not packed in font atlas."), RegionRectIndex);
+
+		// Initialize packer in the same way as the atlas builder, leaving space for padding at the region edges.
+		const int Padding = Atlas.TexGlyphPadding;
+		State->RegionOffset = { Region->X, Region->Y };
+		State->PackerNodes.SetNum(Region->Width - Padding);
+		stbrp_init_target(&State->Packer, Region->Width - Padding, Region->Height - Padding, State->PackerNodes.GetData(),
+			State->PackerNodes.Num());
+
+		// Font data is owned by the atlas, so we can keep font info for the whole lifetime of this object.
+		State->Sources.SetNum(Atlas.ConfigData.Size);
+		for (int Index = 0; Index < Atlas.ConfigData.Size; Index++)
+		{
+			const ImFontConfig& Config = Atlas.ConfigData[Index];
+			FState::FSource& Source = State->Sources[Index];
+
+			const int FontOffset = stbtt_GetFontOffsetForIndex(static_cast<unsigned char*>(Config.FontData), Config.FontNo);
+			Source.bIsValid = FontOffset >= 0 && stbtt_InitFont(&Source.FontInfo, static_cast<unsigned char*>(Config.FontData), FontOffset);
+		}
+	}
+
+	FGlyphRasterizer::~FGlyphRasterizer()
+	{
+	}
+
+	int FGlyphRasterizer::AddPlaceholders(int ConfigIndex, const ImWchar* Ranges)
+	{
+		checkf(State->Sources.IsValidIndex(ConfigIndex), TEXT("Invalid font config index %d."), ConfigIndex);
+
+		const FState::FSource& Source = State->Sources[ConfigIndex];
+		if (!Source.bIsValid)
+		{
+			return 0;
+		}
+
+		const ImFontConfig& Config = Atlas.ConfigData[ConfigIndex];
+		ImFont* Font = Config.DstFont;
+
+		const float Scale = (Config.SizePixels > 0)
+			? stbtt_ScaleForPixelHeight(&Source.FontInfo, Config.SizePixels)
+			: stbtt_ScaleForMappingEmToPixels(&Source.FontInfo, -Config.SizePixels);
+
+		// Source and codepoint are encoded in negative texture coordinates (see DecodePlaceholder).
+		const float V = -static_cast<float>(ConfigIndex + 1);
+
+		int Added = 0;
+		unsigned int LastCodepoint = 0;
+		for (const ImWchar* Range = Ranges; Range[0] && Range[1]; Range += 2)
+		{
+			for (unsigned int Codepoint = FMath::Max<unsigned int>(Range[0], LastCodepoint + 1); Codepoint <= Range[1]; Codepoint++)
+			{
+				LastCodepoint = Codepoint;
+
+				// Skip glyphs which are already in the destination font (including placeholders added by previous
+				// sources) or which are not available in this source.
+				if (Font->FindGlyphNoFallback(static_cast<ImWchar>(Codepoint)))
+				{
+					continue;
+				}
+
+				const int GlyphIndex = stbtt_FindGlyphIndex(&Source.FontInfo, Codepoint);
+				if (!GlyphIndex)
+				{
+					continue;
+				}
+
+				// ImGui uses 16-bit glyph indices with -1 reserved.
+				if (Font->Glyphs.Size >= 0xFFFE)
+				{
+					break;
+				}
+
+				int Advance, LeftSideBearing;
+				stbtt_GetGlyphHMetrics(&Source.FontInfo, GlyphIndex, &Advance, &LeftSideBearing);
+				const float AdvanceX = ImClamp(Scale * Advance, Config.GlyphMinAdvanceX, Config.GlyphMaxAdvanceX);
+
+				// Zero width keeps placeholders invisible, while non-zero height guarantees that texture coordinates
+				// are not modified by clipping.
+				const float U = -static_cast<float>(Codepoint);
+				Font->AddGlyph(static_cast<ImWchar>(Codepoint), 0.f, 0.f, 0.f, 1.f, U, V, U, V, AdvanceX);
+				Added++;
+			}
+		}
+
+		if (Added > 0)
+		{
+			Font->BuildLookupTable();
+			State->NumPlaceholders += Added;
+		}
+
+		return Added;
+	}
+
+	bool FGlyphRasterizer::Rasterize(int ConfigIndex, ImWchar Codepoint, FIntRect& OutRect)
+	{
+		if (!State->Sources.IsValidIndex(ConfigIndex) || !State->Sources[ConfigIndex].bIsValid)
+		{
+			return false;
+		}
+
+		const ImFontConfig& Config = Atlas.ConfigData[ConfigIndex];
+		const stbtt_fontinfo& FontInfo = State->Sources[ConfigIndex].FontInfo;
+		ImFont* Font = Config.DstFont;
+
+		// Make sure that we still have a placeholder from this source.
+		ImFontGlyph* Glyph = const_cast<ImFontGlyph*>(Font->FindGlyphNoFallback(Codepoint));
+		int PlaceholderConfigIndex;
+		ImWchar PlaceholderCodepoint;
+		if (!Glyph || !DecodePlaceholder({ Glyph->U0, Glyph->V0 }, PlaceholderConfigIndex, PlaceholderCodepoint)
+			|| PlaceholderConfigIndex != ConfigIndex)
+		{
+			return false;
+		}
+
+		// Use the same pack range and context settings as the atlas builder, so glyphs rasterised on demand are
+		// identical to baked ones.
+		int RangeCodepoint = Codepoint;
+		stbtt_packedchar PackedChar = {};
+		stbtt_pack_range PackRange = {};
+		PackRange.font_size = Config.SizePixels;
+		PackRange.array_of_unicode_codepoints = &RangeCodepoint;
+		PackRange.num_chars = 1;
+		PackRange.chardata_for_range = &PackedChar;
+
+		stbtt_pack_context PackContext = {};
+		PackContext.width = Atlas.TexWidth;
+		PackContext.height = Atlas.TexHeight;
+		PackContext.stride_in_bytes = Atlas.TexWidth;
+		PackContext.padding = Atlas.TexGlyphPadding;
+		PackContext.pixels = Atlas.TexPixelsAlpha8;
+		PackContext.h_oversample = Config.OversampleH;
+		PackContext.v_oversample = Config.OversampleV;
+
+		const float Scale = (Config.SizePixels > 0)
+			? stbtt_ScaleForPixelHeight(&FontInfo, Config.SizePixels)
+			: stbtt_ScaleForMappingEmToPixels(&FontInfo, -Config.SizePixels);
+		const int GlyphIndex = stbtt_FindGlyphIndex(&FontInfo, Codepoint);
+
+		stbrp_rect Rect = {};
+		if (bSignedDistanceField)
+		{
+			GatherSignedDistanceFieldRect(FontInfo, GlyphIndex, Scale, Atlas.TexGlyphPadding, Rect);
+		}
+		else
+		{
+			stbtt_PackFontRangesGatherRects(&PackContext, &FontInfo, &PackRange, 1, &Rect);
+		}
+		stbrp_pack_rects(&State->Packer, &Rect, 1);
+
+		// Either way, we are replacing this placeholder.
+		State->NumPlaceholders--;
+
+		if (!Rect.was_packed)
+		{
+			if (!State->bIsFull)
+			{
+				State->bIsFull = true;
+				UE_LOG(LogImGui, Warning, TEXT("Dynamic glyph cache is full. Remaining glyphs will be replaced with ")
+					TEXT("a fallback character. Consider increasing the dynamic glyph cache size in ImGui settings."));
+			}
+
+			// Replace placeholder, so it is no longer requested.
+			const ImFontGlyph Placeholder = *Glyph;
+			if (Font->FallbackGlyph && Font->FallbackGlyph != Glyph)
+			{
+				*Glyph = *Font->FallbackGlyph;
+			}
+			else
+			{
+				Glyph->U0 = Glyph->V0 = Glyph->U1 = Glyph->V1 = 0.f;
+			}
+			Glyph->Codepoint = Placeholder.Codepoint;
+			Glyph->AdvanceX = Placeholder.AdvanceX;
+			return false;
+		}
+
+		// Move from region to atlas space and remember the whole modified area (including padding).
+		Rect.x += State->RegionOffset.X;
+		Rect.y += State->RegionOffset.Y;
+		OutRect = { Rect.x, Rect.y, Rect.x + Rect.w, Rect.y + Rect.h };
+
+		if (bSignedDistanceField)
+		{
+			RenderSignedDistanceFieldRect(FontInfo, GlyphIndex, Scale, Atlas.TexGlyphPadding, Atlas.TexPixelsAlpha8,
+				Atlas.TexWidth, Rect, PackedChar);
+		}
+		else
+		{
+			stbtt_PackFontRangesRenderIntoRects(&PackContext, &FontInfo, &PackRange, 1, &Rect);
+		}
+
+		if (Config.RasterizerMultiply != 1.0f && !bSignedDistanceField)
+		{
+			unsigned char MultiplyTable[256];
+			ImFontAtlasBuildMultiplyCalcLookupTable(MultiplyTable, Config.RasterizerMultiply);
+			ImFontAtlasBuildMultiplyRectAlpha8(MultiplyTable, Atlas.TexPixelsAlpha8, Rect.x, Rect.y, Rect.w, Rect.h, Atlas.TexWidth);
+		}
+
+		// Setup glyph in the same way as the atlas builder but keep advance, which is already baked in placeholder.
+		const float FontOffsetX = Config.GlyphOffset.x;
+		const float FontOffsetY = Config.GlyphOffset.y + IM_ROUND(Font->Ascent);
+
+		const float AdvanceOriginal = PackedChar.xadvance;
+		const float AdvanceClamped = ImClamp(AdvanceOriginal, Config.GlyphMinAdvanceX, Config.GlyphMaxAdvanceX);
+		float CharOffsetX = FontOffsetX;
+		if (AdvanceOriginal != AdvanceClamped)
+		{
+			CharOffsetX += Config.PixelSnapH ? ImFloor((AdvanceClamped - AdvanceOriginal) * 0.5f) : (AdvanceClamped - AdvanceOriginal) * 0.5f;
+		}
+
+		stbtt_aligned_quad Quad;
+		float DummyX = 0.f, DummyY = 0.f;
+		stbtt_GetPackedQuad(&PackedChar, Atlas.TexWidth, Atlas.TexHeight, 0, &DummyX, &DummyY, &Quad, 0);
+
+		Glyph->X0 = Quad.x0 + CharOffsetX;
+		Glyph->Y0 = Quad.y0 + FontOffsetY;
+		Glyph->X1 = Quad.x1 + CharOffsetX;
+		Glyph->Y1 = Quad.y1 + FontOffsetY;
+		Glyph->U0 = Quad.s0;
+		Glyph->V0 = Quad.t0;
+		Glyph->U1 = Quad.s1;
+		Glyph->V1 = Quad.t1;
+
+		Font->MetricsTotalSurface += Rect.w * Rect.h;
+
+		return true;
+	}
+
+	int FGlyphRasterizer::GetNumPlaceholders() const
+	{
+		return State->NumPlaceholders;
+	}
 }
@@ -15,4 +15,71 @@ namespace ImGuiImplementation
 	// Set the ImGui Context pointer handle.
 	void SetImGuiContextHandle(ImGuiContext** Handle);
 #endif // WITH_EDITOR
+
+	// Build font atlas. Result is the same as after ImFontAtlas::Build(), but glyphs are rasterised on worker threads.
+	// Only packing, which needs to be deterministic, is done serially. Can be called from any thread.
+	// @param Atlas - Font atlas to build
+	// @param bSignedDistanceField - Whether glyphs should be rendered as signed distance fields (see below)
+	// @returns True, if atlas was successfully built
+	bool BuildFontAtlas(ImFontAtlas& Atlas, bool bSignedDistanceField = false);
+
+	// Signed distance field glyphs have distance to the glyph edge encoded in texture, where edge is at 0.5 and value
+	// changes by 0.5 over the padding range. Oversampling and rasterizer multiply are ignored in this mode.
+	constexpr int SIGNED_DISTANCE_FIELD_PADDING = 4;
+
+	// Rasteriser for glyphs that are added to a font atlas after it was built. Glyphs are packed into an atlas region
+	// reserved with a custom rectangle. Implementation depends on stb libraries compiled as a part of ImGui.
+	class FGlyphRasterizer
+	{
+	public:
+
+		// @param InAtlas - Font atlas which is already built
+		// @param RegionRectIndex - Index of a custom rectangle reserved for glyphs rasterised by this object
+		// @param bInSignedDistanceField - Whether glyphs should be rendered as signed distance fields
+		FGlyphRasterizer(ImFontAtlas& InAtlas, int RegionRectIndex, bool bInSignedDistanceField = false);
+		~FGlyphRasterizer();
+
+		FGlyphRasterizer(const FGlyphRasterizer&) = delete;
+		FGlyphRasterizer& operator=(const FGlyphRasterizer&) = delete;
+
+		// Add placeholders for glyphs from given ranges that are available in the font source but not in its
+		// destination font. Placeholders have correct advance, so they don't affect layout, but they are invisible and
+		// have texture coordinates encoding their source and codepoint, so they can be found in draw data.
+		// @param ConfigIndex - Index of the font source in atlas configuration data
+		// @param Ranges - Zero-terminated list of codepoint ranges
+		// @returns The number of added placeholders
+		int AddPlaceholders(int ConfigIndex, const ImWchar* Ranges);
+
+		// Rasterise glyph in place of its placeholder. If there is no space left, placeholder is replaced with
+		// a fallback glyph.
+		// @param ConfigIndex - Index of the font source in atlas configuration data
+		// @param Codepoint - Codepoint of the glyph
+		// @param OutRect - Atlas area that was modified
+		// @returns True, if glyph was rasterised
+		bool Rasterize(int ConfigIndex, ImWchar Codepoint, FIntRect& OutRect);
+
+		// Get the number of placeholders that are still waiting to be rasterised.
+		int GetNumPlaceholders() const;
+
+		// Decode source and codepoint from placeholder texture coordinates.
+		// @returns True, if texture coordinates belong to a placeholder
+		static bool DecodePlaceholder(const ImVec2& UV, int& OutConfigIndex, ImWchar& OutCodepoint)
+		{
+			if (UV.x < 0.f && UV.y < 0.f)
+			{
+				OutCodepoint = static_cast<ImWchar>(-UV.x);
+				OutConfigIndex = static_cast<int>(-UV.y) - 1;
+				return true;
+			}
+			return false;
+		}
+
+	private:
+
+		struct FState;
+
+		ImFontAtlas& Atlas;
+		TUniquePtr<FState> State;
+		bool bSignedDistanceField;
+	};
 }
@@ -73,8 +73,9 @@ FReply UImGuiInputHandler::OnKeyDown(const FKeyEvent& KeyEvent)
 			ModuleManager->GetProperties().ToggleInput();
 		}
 
-		InputState->SetKeyDown(KeyEvent, true);
+		// Modifiers are copied first, so they are queued together with the key.
 		CopyModifierKeys(KeyEvent);
+		InputState->SetKeyDown(KeyEvent, true);
 
 		return ToReply(bConsume);
 	}
@@ -95,8 +96,8 @@ FReply UImGuiInputHandler::OnKeyUp(const FKeyEvent& KeyEvent)
 	}
 	else
 	{
-		InputState->SetKeyDown(KeyEvent, false);
 		CopyModifierKeys(KeyEvent);
+		InputState->SetKeyDown(KeyEvent, false);
 
 		return ToReply(!ModuleManager->GetProperties().IsKeyboardInputShared());
 	}
@@ -122,12 +123,14 @@ FReply UImGuiInputHandler::OnMouseButtonDown(const FPointerEvent& MouseEvent)
 		return ToReply(false);
 	}
 
+	CopyModifierKeys(MouseEvent);
 	InputState->SetMouseDown(MouseEvent, true);
 	return ToReply(true);
 }
 
 FReply UImGuiInputHandler::OnMouseButtonDoubleClick(const FPointerEvent& MouseEvent)
 {
+	CopyModifierKeys(MouseEvent);
 	InputState->SetMouseDown(MouseEvent, true);
 	return ToReply(true);
 }
@@ -139,6 +142,7 @@ FReply UImGuiInputHandler::OnMouseButtonUp(const FPointerEvent& MouseEvent)
 		return ToReply(false);
 	}
 
+	CopyModifierKeys(MouseEvent);
 	InputState->SetMouseDown(MouseEvent, false);
 	return ToReply(true);
 }
@@ -167,20 +171,19 @@ FReply UImGuiInputHandler::OnMouseMove(const FVector2D& MousePosition)
 
 FReply UImGuiInputHandler::OnTouchStarted(const FVector2D& CursorPosition, const FPointerEvent& TouchEvent)
 {
-	InputState->SetTouchDown(true);
-	InputState->SetTouchPosition(CursorPosition);
+	InputState->AddTouch(TouchEvent.GetPointerIndex(), CursorPosition);
 	return ToReply(true);
 }
 
 FReply UImGuiInputHandler::OnTouchMoved(const FVector2D& CursorPosition, const FPointerEvent& TouchEvent)
 {
-	InputState->SetTouchPosition(CursorPosition);
+	InputState->MoveTouch(TouchEvent.GetPointerIndex(), CursorPosition);
 	return ToReply(true);
 }
 
 FReply UImGuiInputHandler::OnTouchEnded(const FVector2D& CursorPosition, const FPointerEvent& TouchEvent)
 {
-	InputState->SetTouchDown(false);
+	InputState->RemoveTouch(TouchEvent.GetPointerIndex(), CursorPosition);
 	return ToReply(true);
 }
 
@@ -296,9 +299,12 @@ void UImGuiInputHandler::UpdateInputStatePointer()
 	InputState->SetMousePointer(bMouseInputEnabled && ModuleManager->GetSettings().UseSoftwareCursor());
 }
 
-void UImGuiInputHandler::OnSoftwareCursorChanged(bool)
+void UImGuiInputHandler::OnSettingsChanged(EImGuiSettingsChange Changes)
 {
-	UpdateInputStatePointer();
+	if (EnumHasAnyFlags(Changes, EImGuiSettingsChange::SoftwareCursor))
+	{
+		UpdateInputStatePointer();
+	}
 }
 
 void UImGuiInputHandler::OnPostImGuiUpdate()
@@ -327,9 +333,9 @@ void UImGuiInputHandler::Initialize(FImGuiModuleManager* InModuleManager, UGameV
 	ModuleManager->OnPostImGuiUpdate().AddUObject(this, &UImGuiInputHandler::OnPostImGuiUpdate);
 
 	auto& Settings = ModuleManager->GetSettings();
-	if (!Settings.OnUseSoftwareCursorChanged.IsBoundToObject(this))
+	if (!Settings.OnSettingsChanged.IsBoundToObject(this))
 	{
-		Settings.OnUseSoftwareCursorChanged.AddUObject(this, &UImGuiInputHandler::OnSoftwareCursorChanged);
+		Settings.OnSettingsChanged.AddUObject(this, &UImGuiInputHandler::OnSettingsChanged);
 	}
 
 #if WITH_EDITOR
@@ -348,7 +354,7 @@ void UImGuiInputHandler::BeginDestroy()
 
 	if (ModuleManager)
 	{
-		ModuleManager->GetSettings().OnUseSoftwareCursorChanged.RemoveAll(this);
+		ModuleManager->GetSettings().OnSettingsChanged.RemoveAll(this);
 	}
 }
 
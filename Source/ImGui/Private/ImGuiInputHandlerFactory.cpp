@@ -7,7 +7,7 @@
 #include "ImGuiInputHandler.h"
 
 
-UImGuiInputHandler* FImGuiInputHandlerFactory::NewHandler(const FStringClassReference& HandlerClassReference, FImGuiModuleManager* ModuleManager, UGameViewportClient* GameViewport, int32 ContextIndex)
+UClass* FImGuiInputHandlerFactory::GetHandlerClass(const FStringClassReference& HandlerClassReference)
 {
 	UClass* HandlerClass = nullptr;
 	if (HandlerClassReference.IsValid())
@@ -25,6 +25,13 @@ UImGuiInputHandler* FImGuiInputHandlerFactory::NewHandler(const FStringClassRefe
 		HandlerClass = UImGuiInputHandler::StaticClass();
 	}
 
+	return HandlerClass;
+}
+
+UImGuiInputHandler* FImGuiInputHandlerFactory::NewHandler(const FStringClassReference& HandlerClassReference, FImGuiModuleManager* ModuleManager, UGameViewportClient* GameViewport, int32 ContextIndex)
+{
+	UClass* HandlerClass = GetHandlerClass(HandlerClassReference);
+
 	UImGuiInputHandler* Handler = NewObject<UImGuiInputHandler>(GameViewport, HandlerClass);
 	if (Handler)
 	{
@@ -10,6 +10,9 @@ class FImGuiInputHandlerFactory
 {
 public:
 
+	// Get the class of handlers created for the class reference (the default class, if reference is not valid).
+	static UClass* GetHandlerClass(const FStringClassReference& HandlerClassReference);
+
 	static UImGuiInputHandler* NewHandler(const FStringClassReference& HandlerClassReference, FImGuiModuleManager* ModuleManager, UGameViewportClient* GameViewport, int32 ContextIndex);
 
 	static void ReleaseHandler(UImGuiInputHandler* Handler);
@@ -9,6 +9,64 @@
 #include <type_traits>
 
 
+// Queued events older than this (in seconds) are no longer trickled, e.g. when context wasn't updated for a while.
+static constexpr double MAX_INPUT_EVENT_AGE = 0.5;
+
+// Limit (in seconds) for mouse position prediction, so it stays reasonable with low frame-rates.
+static constexpr float MAX_MOUSE_PREDICTION_TIME = 1.f / 30.f;
+
+// Time span (in seconds) of pointer samples used to estimate velocity. Pointers that didn't move for longer than this
+// are considered to be at rest.
+static constexpr double POINTER_VELOCITY_WINDOW = 0.05;
+
+void FImGuiPointerState::AddSample(const FVector2D& InPosition, double Time)
+{
+	Position = InPosition;
+
+	Samples[Head] = FSample{ Time, InPosition };
+	Head = (Head + 1) % MaxSamples;
+	if (NumSamples < MaxSamples)
+	{
+		NumSamples++;
+	}
+}
+
+FVector2D FImGuiPointerState::GetVelocity(double Time) const
+{
+	if (NumSamples < 2)
+	{
+		return FVector2D::ZeroVector;
+	}
+
+	const FSample& Latest = Samples[(Head + MaxSamples - 1) % MaxSamples];
+	if (Time - Latest.Time > POINTER_VELOCITY_WINDOW)
+	{
+		return FVector2D::ZeroVector;
+	}
+
+	// Find the oldest sample in the velocity window, going back from the latest one.
+	const FSample* Oldest = &Latest;
+	for (int32 Age = 2; Age <= NumSamples; Age++)
+	{
+		const FSample& Sample = Samples[(Head + MaxSamples - Age) % MaxSamples];
+		if (Latest.Time - Sample.Time > POINTER_VELOCITY_WINDOW)
+		{
+			break;
+		}
+		Oldest = &Sample;
+	}
+
+	const double TimeSpan = Latest.Time - Oldest->Time;
+	return (TimeSpan > 0.0) ? (Latest.Position - Oldest->Position) / static_cast<float>(TimeSpan) : FVector2D::ZeroVector;
+}
+
+void FImGuiPointerState::Reset(const FVector2D& InPosition)
+{
+	Position = InPosition;
+	Head = 0;
+	NumSamples = 0;
+}
+
 FImGuiInputState::FImGuiInputState()
 {
 	Reset();
@@ -26,7 +84,7 @@ void FImGuiInputState::SetKeyDown(uint32 KeyIndex, bool bIsDown)
 		if (KeysDown[KeyIndex] != bIsDown)
 		{
 			KeysDown[KeyIndex] = bIsDown;
-			KeysUpdateRange.AddPosition(KeyIndex);
+			QueueEvent(EInputEventType::Key, KeyIndex, bIsDown);
 		}
 	}
 }
@@ -38,19 +96,156 @@ void FImGuiInputState::SetMouseDown(uint32 MouseIndex, bool bIsDown)
 		if (MouseButtonsDown[MouseIndex] != bIsDown)
 		{
 			MouseButtonsDown[MouseIndex] = bIsDown;
-			MouseButtonsUpdateRange.AddPosition(MouseIndex);
+			QueueEvent(EInputEventType::MouseButton, MouseIndex, bIsDown);
+		}
+	}
+}
+
+void FImGuiInputState::LatchMousePosition(const FVector2D& CursorPosition, float PredictionTime)
+{
+	if (bMouseLatchEnabled)
+	{
+		const FVector2D Position = MouseLatchTransform.TransformPoint(CursorPosition);
+		if (Position != Mouse.GetPosition())
+		{
+			SetMousePosition(Position);
+		}
+
+		if (bMouseLatchPredict)
+		{
+			// Extrapolate to the moment when the frame will be visible. Prediction is not stored in samples, so it
+			// doesn't affect velocity estimation.
+			MousePrediction = Mouse.GetVelocity(FPlatformTime::Seconds()) * FMath::Clamp(PredictionTime, 0.f, MAX_MOUSE_PREDICTION_TIME);
+		}
+	}
+}
+
+FVector2D FImGuiInputState::GetTouchVelocity() const
+{
+	const FImGuiPointerState* Touch = bTouchDown ? FindTouch(PrimaryTouchIndex) : nullptr;
+	return Touch ? Touch->GetVelocity(FPlatformTime::Seconds()) : FVector2D::ZeroVector;
+}
+
+const FImGuiPointerState* FImGuiInputState::FindTouch(uint32 PointerIndex) const
+{
+	const FTouch* Touch = Touches.FindByPredicate([PointerIndex](const FTouch& Entry) { return Entry.PointerIndex == PointerIndex; });
+	return Touch ? &Touch->Pointer : nullptr;
+}
+
+void FImGuiInputState::AddTouch(uint32 PointerIndex, const FVector2D& Position)
+{
+	if (FindTouch(PointerIndex))
+	{
+		MoveTouch(PointerIndex, Position);
+		return;
+	}
+
+	FTouch& Touch = Touches[Touches.Add(FTouch{ PointerIndex })];
+	Touch.Pointer.AddSample(Position, FPlatformTime::Seconds());
+
+	// Only a touch that starts alone simulates mouse. Touches joining it are available for gestures but they don't
+	// take over the simulated mouse, so ImGui doesn't see the cursor jumping between fingers.
+	if (Touches.Num() == 1)
+	{
+		PrimaryTouchIndex = PointerIndex;
+		TouchPosition = Position;
+		bTouchDown = true;
+	}
+}
+
+void FImGuiInputState::MoveTouch(uint32 PointerIndex, const FVector2D& Position)
+{
+	for (FTouch& Touch : Touches)
+	{
+		if (Touch.PointerIndex == PointerIndex)
+		{
+			Touch.Pointer.AddSample(Position, FPlatformTime::Seconds());
+			if (bTouchDown && PointerIndex == PrimaryTouchIndex)
+			{
+				TouchPosition = Position;
+			}
+			break;
+		}
+	}
+}
+
+void FImGuiInputState::RemoveTouch(uint32 PointerIndex, const FVector2D& Position)
+{
+	MoveTouch(PointerIndex, Position);
+	Touches.RemoveAll([PointerIndex](const FTouch& Touch) { return Touch.PointerIndex == PointerIndex; });
+
+	if (PointerIndex == PrimaryTouchIndex)
+	{
+		bTouchDown = false;
+	}
+}
+
+void FImGuiInputState::QueueEvent(EInputEventType Type, uint32 Index, bool bIsDown)
+{
+	const FEventState State{ Mouse.GetPosition(), bIsControlDown, bIsShiftDown, bIsAltDown };
+	if (!Events.Enqueue(FInputEvent{ FPlatformTime::Seconds(), State, static_cast<uint16>(Index), Type, bIsDown }))
+	{
+		// State arrays are already updated, so we can fall back to copying them (losing only intermediate changes).
+		CollapseEvents();
+	}
+}
+
+void FImGuiInputState::CollapseEvents()
+{
+	Events.Empty();
+
+	// Mark the whole arrays as dirty because potentially each entry could be affected.
+	KeysUpdateIndices.SetFull();
+	MouseButtonsUpdateIndices.SetFull();
+}
+
+bool FImGuiInputState::ApplyQueuedEvents(FKeysArray& OutKeys, FMouseButtonsArray& OutMouseButtons, FEventState& OutEventState)
+{
+	FInputEvent Event;
+	if (Events.Peek(Event) && FPlatformTime::Seconds() - Event.Time > MAX_INPUT_EVENT_AGE)
+	{
+		CollapseEvents();
+		return false;
+	}
+
+	// Keys and buttons changed in this frame, encoded together with their type.
+	TArray<uint32, TInlineAllocator<16>> ChangedInputs;
+
+	while (Events.Peek(Event))
+	{
+		const uint32 InputId = (static_cast<uint32>(Event.Type) << 16) | Event.Index;
+		if (ChangedInputs.Contains(InputId))
+		{
+			// Trickle remaining events to the next frame. To keep the order of events, we stop at the first conflict.
+			return true;
+		}
+		ChangedInputs.Add(InputId);
+
+		if (Event.Type == EInputEventType::Key)
+		{
+			OutKeys[Event.Index] = Event.bIsDown;
 		}
+		else
+		{
+			OutMouseButtons[Event.Index] = Event.bIsDown;
+		}
+		OutEventState = Event.State;
+
+		Events.Dequeue(Event);
 	}
+
+	return false;
 }
 
 void FImGuiInputState::ClearUpdateState()
 {
 	ClearCharacters();
 
-	KeysUpdateRange.SetEmpty();
-	MouseButtonsUpdateRange.SetEmpty();
+	KeysUpdateIndices.SetEmpty();
+	MouseButtonsUpdateIndices.SetEmpty();
 
 	MouseWheelDelta = 0.f;
+	MousePrediction = FVector2D::ZeroVector;
 
 	bTouchProcessed = bTouchDown;
 }
@@ -65,8 +260,8 @@ void FImGuiInputState::ClearKeys()
 	using std::fill;
 	fill(KeysDown, &KeysDown[Utilities::GetArraySize(KeysDown)], false);
 
-	// Mark the whole array as dirty because potentially each entry could be affected.
-	KeysUpdateRange.SetFull();
+	// Queued events would override cleared state, so we drop them and mark the whole arrays as dirty.
+	CollapseEvents();
 }
 
 void FImGuiInputState::ClearMouseButtons()
@@ -74,14 +269,21 @@ void FImGuiInputState::ClearMouseButtons()
 	using std::fill;
 	fill(MouseButtonsDown, &MouseButtonsDown[Utilities::GetArraySize(MouseButtonsDown)], false);
 
-	// Mark the whole array as dirty because potentially each entry could be affected.
-	MouseButtonsUpdateRange.SetFull();
+	// Queued events would override cleared state, so we drop them and mark the whole arrays as dirty.
+	CollapseEvents();
 }
 
 void FImGuiInputState::ClearMouseAnalogue()
 {
-	MousePosition = FVector2D::ZeroVector;
+	Mouse.Reset();
+	MousePrediction = FVector2D::ZeroVector;
 	MouseWheelDelta = 0.f;
+	bMouseLatchEnabled = false;
+
+	// Touches that are down when input is reset won't always get end events, so they need to be dropped here. Otherwise
+	// a single stale touch would prevent following touches from becoming primary.
+	Touches.Reset();
+	bTouchDown = false;
 }
 
 void FImGuiInputState::ClearModifierKeys()
@@ -95,5 +297,6 @@ void FImGuiInputState::ClearNavigationInputs()
 {
 	using std::fill;
 	fill(NavigationInputs, &NavigationInputs[Utilities::GetArraySize(NavigationInputs)], 0.f);
+	ActiveNavigationInputs.SetEmpty();
 }
 
@@ -6,8 +6,50 @@
 #include "Utilities/Arrays.h"
 
 #include <Containers/Array.h>
+#include <Containers/CircularQueue.h>
 
 
+// Position of a pointer (mouse or touch) with a short history of timestamped samples. High-frequency devices like pen
+// tablets can report many moves per frame, so instead of processing each of them, we only store samples in a ring and
+// derive the latest position and velocity when needed.
+class FImGuiPointerState
+{
+public:
+
+	// Add a position sample.
+	// @param InPosition - Pointer position
+	// @param Time - Time of the sample in seconds
+	void AddSample(const FVector2D& InPosition, double Time);
+
+	// Get the latest position.
+	const FVector2D& GetPosition() const { return Position; }
+
+	// Get velocity in units per second, estimated from the most recent samples. Zero, if pointer hasn't moved recently.
+	// @param Time - Current time in seconds
+	FVector2D GetVelocity(double Time) const;
+
+	// Set position and drop the history.
+	// @param InPosition - Pointer position
+	void Reset(const FVector2D& InPosition = FVector2D::ZeroVector);
+
+private:
+
+	struct FSample
+	{
+		double Time;
+		FVector2D Position;
+	};
+
+	static constexpr int32 MaxSamples = 16;
+
+	FSample Samples[MaxSamples];
+	FVector2D Position = FVector2D::ZeroVector;
+
+	// Index where the next sample will be written.
+	int32 Head = 0;
+	int32 NumSamples = 0;
+};
+
 // Collects and stores input state and updates for ImGui IO.
 class FImGuiInputState
 {
@@ -25,11 +67,14 @@ public:
 	// Array for navigation input states.
 	using FNavInputArray = ImGuiInterops::ImGuiTypes::FNavInputArray;
 
-	// Pair of indices defining range in mouse buttons array.
-	using FMouseButtonsIndexRange = Utilities::TArrayIndexRange<FMouseButtonsArray, uint32>;
+	// Set of indices in mouse buttons array.
+	using FMouseButtonsIndexSet = Utilities::TArrayIndexSet<FMouseButtonsArray>;
+
+	// Set of indices in keys array.
+	using FKeysIndexSet = Utilities::TArrayIndexSet<FKeysArray>;
 
-	// Pair of indices defining range in keys array.
-	using FKeysIndexRange = Utilities::TArrayIndexRange<FKeysArray, uint32>;
+	// Set of indices in navigation input array.
+	using FNavInputIndexSet = ImGuiInterops::ImGuiTypes::FNavInputIndexSet;
 
 	// Create empty state with whole range instance with the whole update state marked as dirty.
 	FImGuiInputState();
@@ -45,15 +90,15 @@ public:
 	// Get reference to the array with key down states.
 	const FKeysArray& GetKeys() const { return KeysDown; }
 
-	// Get possibly empty range of indices bounding dirty part of the keys array.
-	const FKeysIndexRange& GetKeysUpdateRange() const { return KeysUpdateRange; }
+	// Get possibly empty set of indices of dirty entries in the keys array.
+	const FKeysIndexSet& GetKeysUpdateIndices() const { return KeysUpdateIndices; }
 
-	// Change state of the key in the keys array and expand range bounding dirty part of the array.
+	// Change state of the key in the keys array and queue that change to be applied in order.
 	// @param KeyEvent - Key event representing the key
 	// @param bIsDown - True, if key is down
 	void SetKeyDown(const FKeyEvent& KeyEvent, bool bIsDown) { SetKeyDown(ImGuiInterops::GetKeyIndex(KeyEvent), bIsDown); }
 
-	// Change state of the key in the keys array and expand range bounding dirty part of the array.
+	// Change state of the key in the keys array and queue that change to be applied in order.
 	// @param Key - Keyboard key
 	// @param bIsDown - True, if key is down
 	void SetKeyDown(const FKey& Key, bool bIsDown) { SetKeyDown(ImGuiInterops::GetKeyIndex(Key), bIsDown); }
@@ -61,19 +106,39 @@ public:
 	// Get reference to the array with mouse button down states.
 	const FMouseButtonsArray& GetMouseButtons() const { return MouseButtonsDown; }
 
-	// Get possibly empty range of indices bounding dirty part of the mouse buttons array.
-	const FMouseButtonsIndexRange& GetMouseButtonsUpdateRange() const { return MouseButtonsUpdateRange; }
+	// Get possibly empty set of indices of dirty entries in the mouse buttons array.
+	const FMouseButtonsIndexSet& GetMouseButtonsUpdateIndices() const { return MouseButtonsUpdateIndices; }
 
-	// Change state of the button in the mouse buttons array and expand range bounding dirty part of the array.
+	// Change state of the button in the mouse buttons array and queue that change to be applied in order.
 	// @param MouseEvent - Mouse event representing mouse button
 	// @param bIsDown - True, if button is down
 	void SetMouseDown(const FPointerEvent& MouseEvent, bool bIsDown) { SetMouseDown(ImGuiInterops::GetMouseIndex(MouseEvent), bIsDown); }
 
-	// Change state of the button in the mouse buttons array and expand range bounding dirty part of the array.
+	// Change state of the button in the mouse buttons array and queue that change to be applied in order.
 	// @param MouseButton - Mouse button key
 	// @param bIsDown - True, if button is down
 	void SetMouseDown(const FKey& MouseButton, bool bIsDown) { SetMouseDown(ImGuiInterops::GetMouseIndex(MouseButton), bIsDown); }
 
+	// State of mouse position and modifier keys at the moment of a queued event.
+	struct FEventState
+	{
+		FVector2D MousePosition;
+		bool bIsControlDown;
+		bool bIsShiftDown;
+		bool bIsAltDown;
+	};
+
+	// Apply queued key and mouse button events to ImGui state arrays. ImGui samples those states once per frame, so only
+	// the first change of each key or button is applied and the remaining events are left for the next frames. This way
+	// quick taps and clicks are not lost when ImGui updates slower than input arrives. Events that stay in the queue for
+	// too long are collapsed to the current state (@see GetKeysUpdateIndices and GetMouseButtonsUpdateIndices).
+	// @param OutKeys - Keys array to which events should be applied
+	// @param OutMouseButtons - Mouse buttons array to which events should be applied
+	// @param OutEventState - If some events are left in the queue, set to the mouse position and modifier keys at the
+	//     moment of the last applied event
+	// @returns True, if some events are left in the queue
+	bool ApplyQueuedEvents(FKeysArray& OutKeys, FMouseButtonsArray& OutMouseButtons, FEventState& OutEventState);
+
 	// Get mouse wheel delta accumulated during the last frame.
 	float GetMouseWheelDelta() const { return MouseWheelDelta; }
 
@@ -82,11 +147,38 @@ public:
 	void AddMouseWheelDelta(float DeltaValue) { MouseWheelDelta += DeltaValue; }
 
 	// Get the mouse position.
-	const FVector2D& GetMousePosition() const { return MousePosition; }
+	const FVector2D& GetMousePosition() const { return Mouse.GetPosition(); }
+
+	// Get the mouse velocity in units per second.
+	FVector2D GetMouseVelocity() const { return Mouse.GetVelocity(FPlatformTime::Seconds()); }
 
-	// Set the mouse position.
+	// Set the mouse position. Positions are sampled, so this can be called for every move event.
 	// @param Position - Mouse position
-	void SetMousePosition(const FVector2D& Position) { MousePosition = Position; }
+	void SetMousePosition(const FVector2D& Position) { Mouse.AddSample(Position, FPlatformTime::Seconds()); }
+
+	// Get the offset by which mouse position should be moved in the next frame to compensate for latency. Non-zero only
+	// in predictive mode, after mouse position was latched.
+	const FVector2D& GetMousePrediction() const { return MousePrediction; }
+
+	// Enable sampling of the cursor position right before ImGui starts a new frame (@see LatchMousePosition).
+	// @param ScreenToImGui - Transform from screen to ImGui space
+	// @param bPredict - Whether latched position should be extrapolated using mouse velocity
+	void EnableMouseLatch(const FSlateRenderTransform& ScreenToImGui, bool bPredict)
+	{
+		MouseLatchTransform = ScreenToImGui;
+		bMouseLatchEnabled = true;
+		bMouseLatchPredict = bPredict;
+	}
+
+	// Disable sampling of the cursor position, so mouse position is only updated by move events.
+	void DisableMouseLatch() { bMouseLatchEnabled = false; }
+
+	// If mouse latch is enabled, update mouse position with the current cursor position. Called at the latest possible
+	// moment before ImGui starts a new frame, what means that ImGui can see cursor moves that happened after the last
+	// Slate update.
+	// @param CursorPosition - Cursor position in screen space
+	// @param PredictionTime - Time in seconds by which position should be extrapolated in predictive mode
+	void LatchMousePosition(const FVector2D& CursorPosition, float PredictionTime);
 
 	// Check whether input has active mouse pointer.
 	bool HasMousePointer() const { return bHasMousePointer; }
@@ -99,19 +191,37 @@ public:
 	// One frame delay is used to process mouse release in ImGui since touch-down is simulated with mouse-down.
 	bool IsTouchActive() const { return bTouchDown || bTouchProcessed; }
 
-	// Check whether touch input is down.
+	// Check whether the primary touch is down. Primary touch is the one started when no other touch was active and it
+	// is the only one simulating mouse in ImGui.
 	bool IsTouchDown() const { return bTouchDown; }
 
-	// Set whether touch input is down.
-	// @param bIsDown - True, if touch is down (or started) and false, if touch is up (or ended)
-	void SetTouchDown(bool bIsDown) { bTouchDown = bIsDown; }
-
-	// Get the touch position.
+	// Get the position of the primary touch. After touch has ended, this is the position where it was released.
 	const FVector2D& GetTouchPosition() const { return TouchPosition; }
 
-	// Set the touch position.
+	// Get the velocity of the primary touch in units per second.
+	FVector2D GetTouchVelocity() const;
+
+	// Get the number of touches that are down.
+	int32 GetTouchCount() const { return Touches.Num(); }
+
+	// Get the state of the touch with given pointer index or null, if that touch is not down.
+	// @param PointerIndex - Pointer index of the touch
+	const FImGuiPointerState* FindTouch(uint32 PointerIndex) const;
+
+	// Start a touch.
+	// @param PointerIndex - Pointer index of the touch
+	// @param Position - Touch position
+	void AddTouch(uint32 PointerIndex, const FVector2D& Position);
+
+	// Update position of a touch. Positions are sampled, so this can be called for every move event.
+	// @param PointerIndex - Pointer index of the touch
 	// @param Position - Touch position
-	void SetTouchPosition(const FVector2D& Position) { TouchPosition = Position; }
+	void MoveTouch(uint32 PointerIndex, const FVector2D& Position);
+
+	// End a touch.
+	// @param PointerIndex - Pointer index of the touch
+	// @param Position - Position where the touch was released
+	void RemoveTouch(uint32 PointerIndex, const FVector2D& Position);
 
 	// Get Control down state.
 	bool IsControlDown() const { return bIsControlDown; }
@@ -137,15 +247,19 @@ public:
 	// Get reference to the array with navigation input states.
 	const FNavInputArray& GetNavigationInputs() const { return NavigationInputs; }
 
+	// Get set of indices of non-zero entries in the navigation input array. ImGui clears its navigation inputs at the
+	// end of every frame, so only those entries need to be copied.
+	const FNavInputIndexSet& GetActiveNavigationInputs() const { return ActiveNavigationInputs; }
+
 	// Change state of the navigation input associated with this gamepad key.
 	// @param KeyEvent - Key event with gamepad key input
 	// @param bIsDown - True, if key is down
-	void SetGamepadNavigationKey(const FKeyEvent& KeyEvent, bool bIsDown) { ImGuiInterops::SetGamepadNavigationKey(NavigationInputs, KeyEvent.GetKey(), bIsDown); }
+	void SetGamepadNavigationKey(const FKeyEvent& KeyEvent, bool bIsDown) { ImGuiInterops::SetGamepadNavigationKey(NavigationInputs, ActiveNavigationInputs, KeyEvent.GetKey(), bIsDown); }
 
 	// Change state of the navigation input associated with this gamepad axis.
 	// @param AnalogInputEvent - Analogue input event with gamepad axis input
 	// @param Value - Analogue value that should be set for this axis
-	void SetGamepadNavigationAxis(const FAnalogInputEvent& AnalogInputEvent, float Value) { ImGuiInterops::SetGamepadNavigationAxis(NavigationInputs, AnalogInputEvent.GetKey(), Value); }
+	void SetGamepadNavigationAxis(const FAnalogInputEvent& AnalogInputEvent, float Value) { ImGuiInterops::SetGamepadNavigationAxis(NavigationInputs, ActiveNavigationInputs, AnalogInputEvent.GetKey(), Value); }
 
 	// Check whether keyboard navigation is enabled.
 	bool IsKeyboardNavigationEnabled() const { return bKeyboardNavigationEnabled; }
@@ -198,11 +312,32 @@ public:
 	}
 
 	// Clear part of the state that is meant to be updated in every frame like: accumulators, buffers, navigation data
-	// and information about dirty parts of keys or mouse buttons arrays.
+	// and information about dirty parts of keys or mouse buttons arrays. Queued events are not affected.
 	void ClearUpdateState();
 
 private:
 
+	enum class EInputEventType : uint8
+	{
+		Key,
+		MouseButton
+	};
+
+	// Change of a key or mouse button state, queued to be applied in order.
+	struct FInputEvent
+	{
+		double Time;
+		FEventState State;
+		uint16 Index;
+		EInputEventType Type;
+		bool bIsDown;
+	};
+
+	void QueueEvent(EInputEventType Type, uint32 Index, bool bIsDown);
+
+	// Drop queued events and mark whole arrays as dirty, so the current state is copied at once.
+	void CollapseEvents();
+
 	void SetKeyDown(uint32 KeyIndex, bool bIsDown);
 	void SetMouseDown(uint32 MouseIndex, bool IsDown);
 
@@ -213,21 +348,40 @@ private:
 	void ClearModifierKeys();
 	void ClearNavigationInputs();
 
-	FVector2D MousePosition = FVector2D::ZeroVector;
+	struct FTouch
+	{
+		uint32 PointerIndex;
+		FImGuiPointerState Pointer;
+	};
+
+	FImGuiPointerState Mouse;
+	FVector2D MousePrediction = FVector2D::ZeroVector;
+	FSlateRenderTransform MouseLatchTransform;
+
+	// Touches that are down, in order in which they started.
+	TArray<FTouch, TInlineAllocator<4>> Touches;
+	uint32 PrimaryTouchIndex = 0;
 	FVector2D TouchPosition = FVector2D::ZeroVector;
+
 	float MouseWheelDelta = 0.f;
 
 	FMouseButtonsArray MouseButtonsDown;
-	FMouseButtonsIndexRange MouseButtonsUpdateRange;
+	FMouseButtonsIndexSet MouseButtonsUpdateIndices;
 
 	FCharactersBuffer InputCharacters;
 
 	FKeysArray KeysDown;
-	FKeysIndexRange KeysUpdateRange;
+	FKeysIndexSet KeysUpdateIndices;
 
 	FNavInputArray NavigationInputs;
+	FNavInputIndexSet ActiveNavigationInputs;
+
+	// Lock-free ring with a fixed capacity. If it gets full, events are collapsed to the current state.
+	TCircularQueue<FInputEvent> Events{ 64 };
 
 	bool bHasMousePointer = false;
+	bool bMouseLatchEnabled = false;
+	bool bMouseLatchPredict = false;
 	bool bTouchDown = false;
 	bool bTouchProcessed = false;
 
@@ -4,6 +4,7 @@
 
 #include "ImGuiInteroperability.h"
 #include "ImGuiInputState.h"
+#include "ImGuiModuleSettings.h"
 #include "Utilities/Arrays.h"
 
 
@@ -59,13 +60,11 @@ namespace
 		copy(begin(Src), end(Src), begin(Dst));
 	}
 
-	// Copy subrange of source array to destination array of the same size.
-	template<typename TArray, typename SizeType>
-	void Copy(const TArray& Src, TArray& Dst, const Utilities::TArrayIndexRange<TArray, SizeType>& Range)
+	// Copy elements at given indices from source array to destination array of the same size.
+	template<typename TArray, std::size_t N>
+	void Copy(const TArray& Src, TArray& Dst, const Utilities::TIndexSet<N>& Indices)
 	{
-		using std::copy;
-		using std::begin;
-		copy(begin(Src) + Range.GetBegin(), begin(Src) + Range.GetEnd(), begin(Dst) + Range.GetBegin());
+		Indices.ForEach([&](uint32 Index) { Dst[Index] = Src[Index]; });
 	}
 
 	// Copy number of elements from the beginning of source array to the beginning of destination array of the same size.
@@ -78,6 +77,81 @@ namespace
 		using std::begin;
 		copy(begin(Src), begin(Src) + Count, begin(Dst));
 	}
+
+	//====================================================================================================
+	// Key Mapping
+	//====================================================================================================
+
+	uint32 FindKeyIndex(const FKey& Key)
+	{
+		const uint32* pKeyCode = nullptr;
+		const uint32* pCharCode = nullptr;
+
+		FInputKeyManager::Get().GetCodesFromKey(Key, pKeyCode, pCharCode);
+
+		if (pKeyCode)
+		{
+			return *pKeyCode;
+		}
+
+		if (pCharCode)
+		{
+			return *pCharCode;
+		}
+
+		return 0;
+	}
+
+	// Input key manager finds codes by searching through its maps, so instead we map all keys once and then use this
+	// table for lookups. Keys added after the table was created are mapped and added on their first use. Codes come from
+	// the platform key map, which input settings don't affect (they only bind actions and axes to keys), so the table
+	// doesn't need to be rebuilt when they change.
+	class FKeyIndexTable
+	{
+	public:
+
+		static FKeyIndexTable& Get()
+		{
+			static FKeyIndexTable Instance;
+			return Instance;
+		}
+
+		uint32 GetKeyIndex(const FKey& Key)
+		{
+			if (const uint32* Index = KeyIndices.Find(Key))
+			{
+				return *Index;
+			}
+
+			return KeyIndices.Add(Key, FindKeyIndex(Key));
+		}
+
+	private:
+
+		FKeyIndexTable()
+		{
+			TArray<FKey> AllKeys;
+			EKeys::GetAllKeys(AllKeys);
+
+			KeyIndices.Reserve(AllKeys.Num());
+			for (const FKey& Key : AllKeys)
+			{
+				KeyIndices.Add(Key, FindKeyIndex(Key));
+			}
+		}
+
+		TMap<FKey, uint32> KeyIndices;
+	};
+
+	// Mouse buttons at indices of mouse buttons buffer.
+	const FKey* const MouseButtons[] =
+	{
+		&EKeys::LeftMouseButton,
+		&EKeys::RightMouseButton,
+		&EKeys::MiddleMouseButton,
+		&EKeys::ThumbMouseButton,
+		&EKeys::ThumbMouseButton2
+	};
 }
 
 namespace ImGuiInterops
@@ -125,45 +199,18 @@ namespace ImGuiInterops
 
 	uint32 GetKeyIndex(const FKey& Key)
 	{
-		const uint32* pKeyCode = nullptr;
-		const uint32* pCharCode = nullptr;
-
-		FInputKeyManager::Get().GetCodesFromKey(Key, pKeyCode, pCharCode);
-
-		if (pKeyCode)
-		{
-			return *pKeyCode;
-		}
-
-		if (pCharCode)
-		{
-			return *pCharCode;
-		}
-
-		return 0;
+		return FKeyIndexTable::Get().GetKeyIndex(Key);
 	}
 
 	uint32 GetMouseIndex(const FKey& MouseButton)
 	{
-		if (MouseButton == EKeys::LeftMouseButton)
-		{
-			return 0;
-		}
-		else if (MouseButton == EKeys::MiddleMouseButton)
-		{
-			return 2;
-		}
-		else if (MouseButton == EKeys::RightMouseButton)
-		{
-			return 1;
-		}
-		else if (MouseButton == EKeys::ThumbMouseButton)
+		// Key comparison is reduced to name comparison, so scanning a few entries is cheap.
+		for (uint32 Index = 0; Index < Utilities::GetArraySize(MouseButtons); Index++)
 		{
-			return 3;
-		}
-		else if (MouseButton == EKeys::ThumbMouseButton2)
-		{
-			return 4;
+			if (MouseButton == *MouseButtons[Index])
+			{
+				return Index;
+			}
 		}
 
 		return -1;
@@ -195,73 +242,165 @@ namespace ImGuiInterops
 
 	namespace
 	{
-		inline void UpdateKey(const FKey& Key, const FKey& KeyCondition, float& Value, bool bIsDown)
-		{
-			if (Key == KeyCondition)
-			{
-				Value = (bIsDown) ? 1.f : 0.f;
-			}
-		}
+		constexpr uint8 NO_NAV_INPUT = static_cast<uint8>(EImGuiNavInput::None);
 
-		inline void UpdateAxisValues(float& Axis, float& Opposite, float Value)
+		// Navigation inputs bound to a gamepad key. Keys set the positive input, axes set the positive or the negative
+		// input, depending on the sign of their value.
+		struct FNavInputBinding
 		{
-			constexpr float AxisInputThreshold = 0.166f;
+			uint8 Positive;
+			uint8 Negative;
+		};
 
-			// Filter out small values to avoid false positives (helpful in case of worn controllers).
-			Axis = FMath::Max(0.f, Value - AxisInputThreshold);
-			Opposite = 0.f;
-		}
+		using FNavInputBindings = TArray<FNavInputBinding, TInlineAllocator<2>>;
+
+		// Default mapping of gamepad keys to navigation inputs.
+		const struct
+		{
+			const FKey* Key;
+			uint8 Positive;
+			uint8 Negative;
+		} DefaultNavInputMapping[] =
+		{
+			{ &EKeys::Gamepad_FaceButton_Bottom, ImGuiNavInput_Activate, NO_NAV_INPUT },
+			{ &EKeys::Gamepad_FaceButton_Right, ImGuiNavInput_Cancel, NO_NAV_INPUT },
+			{ &EKeys::Gamepad_FaceButton_Top, ImGuiNavInput_Input, NO_NAV_INPUT },
+			{ &EKeys::Gamepad_FaceButton_Left, ImGuiNavInput_Menu, NO_NAV_INPUT },
+			{ &EKeys::Gamepad_DPad_Left, ImGuiNavInput_DpadLeft, NO_NAV_INPUT },
+			{ &EKeys::Gamepad_DPad_Right, ImGuiNavInput_DpadRight, NO_NAV_INPUT },
+			{ &EKeys::Gamepad_DPad_Up, ImGuiNavInput_DpadUp, NO_NAV_INPUT },
+			{ &EKeys::Gamepad_DPad_Down, ImGuiNavInput_DpadDown, NO_NAV_INPUT },
+			{ &EKeys::Gamepad_LeftShoulder, ImGuiNavInput_FocusPrev, NO_NAV_INPUT },
+			{ &EKeys::Gamepad_RightShoulder, ImGuiNavInput_FocusNext, NO_NAV_INPUT },
+			{ &EKeys::Gamepad_LeftShoulder, ImGuiNavInput_TweakSlow, NO_NAV_INPUT },
+			{ &EKeys::Gamepad_RightShoulder, ImGuiNavInput_TweakFast, NO_NAV_INPUT },
+			{ &EKeys::Gamepad_LeftX, ImGuiNavInput_LStickRight, ImGuiNavInput_LStickLeft },
+			{ &EKeys::Gamepad_LeftY, ImGuiNavInput_LStickUp, ImGuiNavInput_LStickDown },
+		};
 
-		inline void UpdateSymmetricAxis(const FKey& Key, const FKey& KeyCondition, float& Negative, float& Positive, float Value)
+		// Resolved mapping of gamepad keys to navigation inputs, so each event needs only one lookup.
+		class FNavInputTable
 		{
-			if (Key == KeyCondition)
+		public:
+
+			static FNavInputTable& Get()
 			{
-				if (Value < 0.f)
+				static FNavInputTable Instance;
+				return Instance;
+			}
+
+			const FNavInputBindings* Find(const FKey& Key) const
+			{
+				return Bindings.Find(Key);
+			}
+
+			void SetMapping(const TArray<FImGuiNavInputMapping>& Overrides)
+			{
+				Bindings.Reset();
+
+				for (const auto& Mapping : DefaultNavInputMapping)
 				{
-					UpdateAxisValues(Negative, Positive, -Value);
+					Bindings.FindOrAdd(*Mapping.Key).Add({ Mapping.Positive, Mapping.Negative });
 				}
-				else
+
+				// Overrides replace all default bindings of their keys.
+				TSet<FKey> OverriddenKeys;
+				for (const FImGuiNavInputMapping& Mapping : Overrides)
 				{
-					UpdateAxisValues(Positive, Negative, Value);
+					if (!Mapping.Key.IsValid())
+					{
+						continue;
+					}
+
+					bool bAlreadyOverridden = false;
+					OverriddenKeys.Add(Mapping.Key, &bAlreadyOverridden);
+					if (!bAlreadyOverridden)
+					{
+						Bindings.Remove(Mapping.Key);
+					}
+
+					if (Mapping.NavInput != EImGuiNavInput::None || Mapping.NegativeNavInput != EImGuiNavInput::None)
+					{
+						Bindings.FindOrAdd(Mapping.Key).Add({ static_cast<uint8>(Mapping.NavInput), static_cast<uint8>(Mapping.NegativeNavInput) });
+					}
 				}
 			}
-		}
-	}
 
-	void SetGamepadNavigationKey(ImGuiTypes::FNavInputArray& NavInputs, const FKey& Key, bool bIsDown)
-	{
-#define MAP_KEY(KeyCondition, NavIndex) UpdateKey(Key, KeyCondition, NavInputs[NavIndex], bIsDown)
+		private:
+
+			FNavInputTable()
+			{
+				SetMapping({});
+			}
+
+			TMap<FKey, FNavInputBindings> Bindings;
+		};
 
-		if (Key.IsGamepadKey())
+		// Set navigation input and keep track of non-zero entries.
+		inline void SetNavInput(ImGuiTypes::FNavInputArray& NavInputs, ImGuiTypes::FNavInputIndexSet& ActiveNavInputs,
+			uint32 NavIndex, float Value)
 		{
-			MAP_KEY(EKeys::Gamepad_FaceButton_Bottom, ImGuiNavInput_Activate);
-			MAP_KEY(EKeys::Gamepad_FaceButton_Right, ImGuiNavInput_Cancel);
-			MAP_KEY(EKeys::Gamepad_FaceButton_Top, ImGuiNavInput_Input);
-			MAP_KEY(EKeys::Gamepad_FaceButton_Left, ImGuiNavInput_Menu);
-			MAP_KEY(EKeys::Gamepad_DPad_Left, ImGuiNavInput_DpadLeft);
-			MAP_KEY(EKeys::Gamepad_DPad_Right, ImGuiNavInput_DpadRight);
-			MAP_KEY(EKeys::Gamepad_DPad_Up, ImGuiNavInput_DpadUp);
-			MAP_KEY(EKeys::Gamepad_DPad_Down, ImGuiNavInput_DpadDown);
-			MAP_KEY(EKeys::Gamepad_LeftShoulder, ImGuiNavInput_FocusPrev);
-			MAP_KEY(EKeys::Gamepad_RightShoulder, ImGuiNavInput_FocusNext);
-			MAP_KEY(EKeys::Gamepad_LeftShoulder, ImGuiNavInput_TweakSlow);
-			MAP_KEY(EKeys::Gamepad_RightShoulder, ImGuiNavInput_TweakFast);
+			if (NavIndex >= Utilities::GetArraySize(NavInputs))
+			{
+				return;
+			}
+
+			NavInputs[NavIndex] = Value;
+			if (Value != 0.f)
+			{
+				ActiveNavInputs.Add(NavIndex);
+			}
+			else
+			{
+				ActiveNavInputs.Remove(NavIndex);
+			}
 		}
 
-#undef MAP_KEY
+		inline void UpdateAxisValues(ImGuiTypes::FNavInputArray& NavInputs, ImGuiTypes::FNavInputIndexSet& ActiveNavInputs,
+			uint32 Axis, uint32 Opposite, float Value)
+		{
+			constexpr float AxisInputThreshold = 0.166f;
+
+			// Filter out small values to avoid false positives (helpful in case of worn controllers).
+			SetNavInput(NavInputs, ActiveNavInputs, Axis, FMath::Max(0.f, Value - AxisInputThreshold));
+			SetNavInput(NavInputs, ActiveNavInputs, Opposite, 0.f);
+		}
 	}
 
-	void SetGamepadNavigationAxis(ImGuiTypes::FNavInputArray& NavInputs, const FKey& Key, float Value)
+	void SetGamepadNavigationMapping(const TArray<FImGuiNavInputMapping>& Overrides)
 	{
-#define MAP_SYMMETRIC_AXIS(KeyCondition, NegNavIndex, PosNavIndex) UpdateSymmetricAxis(Key, KeyCondition, NavInputs[NegNavIndex], NavInputs[PosNavIndex], Value)
+		FNavInputTable::Get().SetMapping(Overrides);
+	}
 
-		if (Key.IsGamepadKey())
+	void SetGamepadNavigationKey(ImGuiTypes::FNavInputArray& NavInputs, ImGuiTypes::FNavInputIndexSet& ActiveNavInputs,
+		const FKey& Key, bool bIsDown)
+	{
+		if (const FNavInputBindings* Bindings = FNavInputTable::Get().Find(Key))
 		{
-			MAP_SYMMETRIC_AXIS(EKeys::Gamepad_LeftX, ImGuiNavInput_LStickLeft, ImGuiNavInput_LStickRight);
-			MAP_SYMMETRIC_AXIS(EKeys::Gamepad_LeftY, ImGuiNavInput_LStickDown, ImGuiNavInput_LStickUp);
+			for (const FNavInputBinding& Binding : *Bindings)
+			{
+				SetNavInput(NavInputs, ActiveNavInputs, Binding.Positive, (bIsDown) ? 1.f : 0.f);
+			}
 		}
+	}
 
-#undef MAP_SYMMETRIC_AXIS
+	void SetGamepadNavigationAxis(ImGuiTypes::FNavInputArray& NavInputs, ImGuiTypes::FNavInputIndexSet& ActiveNavInputs,
+		const FKey& Key, float Value)
+	{
+		if (const FNavInputBindings* Bindings = FNavInputTable::Get().Find(Key))
+		{
+			for (const FNavInputBinding& Binding : *Bindings)
+			{
+				if (Value < 0.f)
+				{
+					UpdateAxisValues(NavInputs, ActiveNavInputs, Binding.Negative, Binding.Positive, -Value);
+				}
+				else
+				{
+					UpdateAxisValues(NavInputs, ActiveNavInputs, Binding.Positive, Binding.Negative, Value);
+				}
+			}
+		}
 	}
 
 	//====================================================================================================
@@ -274,7 +413,7 @@ namespace ImGuiInterops
 		Flags = bSet ? Flags | Flag : Flags & ~Flag;
 	}
 
-	void CopyInput(ImGuiIO& IO, const FImGuiInputState& InputState)
+	void CopyInput(ImGuiIO& IO, FImGuiInputState& InputState)
 	{
 		static const uint32 LeftControl = GetKeyIndex(EKeys::LeftControl);
 		static const uint32 RightControl = GetKeyIndex(EKeys::RightControl);
@@ -289,17 +428,24 @@ namespace ImGuiInterops
 		IO.KeyAlt = InputState.IsAltDown();
 		IO.KeySuper = false;
 
-		// Copy buffers.
-		if (!InputState.GetKeysUpdateRange().IsEmpty())
-		{
-			Copy(InputState.GetKeys(), IO.KeysDown, InputState.GetKeysUpdateRange());
-		}
+		// Apply queued key and mouse button events. This needs to be done before copying buffers, because if events
+		// cannot be applied, they are collapsed to dirty ranges.
+		FImGuiInputState::FEventState TrickledState;
+		const bool bIsTrickling = InputState.ApplyQueuedEvents(IO.KeysDown, IO.MouseDown, TrickledState);
 
-		if (!InputState.GetMouseButtonsUpdateRange().IsEmpty())
+		// If events are trickled, use modifiers at the moment of the last applied event, so shortcuts are not split
+		// from their modifiers (like Ctrl released before delayed C arrives).
+		if (bIsTrickling)
 		{
-			Copy(InputState.GetMouseButtons(), IO.MouseDown, InputState.GetMouseButtonsUpdateRange());
+			IO.KeyCtrl = TrickledState.bIsControlDown;
+			IO.KeyShift = TrickledState.bIsShiftDown;
+			IO.KeyAlt = TrickledState.bIsAltDown;
 		}
 
+		// Copy buffers.
+		Copy(InputState.GetKeys(), IO.KeysDown, InputState.GetKeysUpdateIndices());
+		Copy(InputState.GetMouseButtons(), IO.MouseDown, InputState.GetMouseButtonsUpdateIndices());
+
 		for (const TCHAR Char : InputState.GetCharacters())
 		{
 			IO.AddInputCharacter(CastInputChar(Char));
@@ -307,7 +453,8 @@ namespace ImGuiInterops
 
 		if (InputState.IsGamepadNavigationEnabled() && InputState.HasGamepad())
 		{
-			Copy(InputState.GetNavigationInputs(), IO.NavInputs);
+			// Navigation inputs are cleared by ImGui at the end of every frame, so we only need to copy non-zero ones.
+			Copy(InputState.GetNavigationInputs(), IO.NavInputs, InputState.GetActiveNavigationInputs());
 		}
 
 		SetFlag(IO.ConfigFlags, ImGuiConfigFlags_NavEnableKeyboard, InputState.IsKeyboardNavigationEnabled());
@@ -329,9 +476,12 @@ namespace ImGuiInterops
 		}
 		else
 		{
-			// Copy the mouse position.
-			IO.MousePos.x = InputState.GetMousePosition().X;
-			IO.MousePos.y = InputState.GetMousePosition().Y;
+			// Copy the mouse position. If events are trickled, use position at the moment of the last applied event, so
+			// clicks land where they happened. Otherwise, use the latest position with optional prediction.
+			const FVector2D MousePosition = bIsTrickling ? TrickledState.MousePosition
+				: InputState.GetMousePosition() + InputState.GetMousePrediction();
+			IO.MousePos.x = MousePosition.X;
+			IO.MousePos.y = MousePosition.Y;
 
 			// Copy mouse wheel delta.
 			IO.MouseWheel += InputState.GetMouseWheelDelta();
@@ -3,6 +3,7 @@
 #pragma once
 
 #include "TextureManager.h"
+#include "Utilities/Arrays.h"
 
 #include <GenericPlatform/ICursor.h>
 
@@ -10,6 +11,7 @@
 
 
 class FImGuiInputState;
+struct FImGuiNavInputMapping;
 
 // Utilities to help standardise operations between Unreal and ImGui.
 namespace ImGuiInterops
@@ -23,6 +25,7 @@ namespace ImGuiInterops
 		using FMouseButtonsArray = decltype(ImGuiIO::MouseDown);
 		using FKeysArray = decltype(ImGuiIO::KeysDown);
 		using FNavInputArray = decltype(ImGuiIO::NavInputs);
+		using FNavInputIndexSet = Utilities::TArrayIndexSet<FNavInputArray>;
 
 		using FKeyMap = decltype(ImGuiIO::KeyMap);
 	}
@@ -35,7 +38,7 @@ namespace ImGuiInterops
 	// Set in ImGui IO mapping to recognize indices generated from Unreal input events.
 	void SetUnrealKeyMap(ImGuiIO& IO);
 
-	// Map FKey to index in keys buffer.
+	// Map FKey to index in keys buffer. Indices are mapped once and stored in a lookup table.
 	uint32 GetKeyIndex(const FKey& Key);
 
 	// Map key event to index in keys buffer.
@@ -56,27 +59,36 @@ namespace ImGuiInterops
 	// Convert from ImGuiMouseCursor type to EMouseCursor.
 	EMouseCursor::Type ToSlateMouseCursor(ImGuiMouseCursor MouseCursor);
 
+	// Set mapping of gamepad keys to navigation inputs. Mapping is resolved into a table, so gamepad events can be
+	// mapped with a single lookup.
+	// @param Overrides - Mappings that replace default mappings of their keys
+	void SetGamepadNavigationMapping(const TArray<FImGuiNavInputMapping>& Overrides);
+
 	// Set in the target array navigation input corresponding to gamepad key.
 	// @param NavInputs - Target array
+	// @param ActiveNavInputs - Set of non-zero entries in the target array, updated together with the array
 	// @param Key - Gamepad key mapped to navigation input (non-mapped keys will be ignored)
 	// @param bIsDown - True, if key is down 
-	void SetGamepadNavigationKey(ImGuiTypes::FNavInputArray& NavInputs, const FKey& Key, bool bIsDown);
+	void SetGamepadNavigationKey(ImGuiTypes::FNavInputArray& NavInputs, ImGuiTypes::FNavInputIndexSet& ActiveNavInputs,
+		const FKey& Key, bool bIsDown);
 
 	// Set in the target array navigation input corresponding to gamepad axis.
 	// @param NavInputs - Target array
+	// @param ActiveNavInputs - Set of non-zero entries in the target array, updated together with the array
 	// @param Key - Gamepad axis key mapped to navigation input (non-axis or non-mapped inputs will be ignored)
 	// @param Value - Axis value (-1..1 values from Unreal are mapped to separate ImGui axes with values in range 0..1)
-	void SetGamepadNavigationAxis(ImGuiTypes::FNavInputArray& NavInputs, const FKey& Key, float Value);
+	void SetGamepadNavigationAxis(ImGuiTypes::FNavInputArray& NavInputs, ImGuiTypes::FNavInputIndexSet& ActiveNavInputs,
+		const FKey& Key, float Value);
 
 
 	//====================================================================================================
 	// Input State Copying
 	//====================================================================================================
 
-	// Copy input to ImGui IO.
+	// Copy input to ImGui IO. Consumes queued input events that are applied in this frame.
 	// @param IO - Target ImGui IO
 	// @param InputState - Input state to copy
-	void CopyInput(ImGuiIO& IO, const FImGuiInputState& InputState);
+	void CopyInput(ImGuiIO& IO, FImGuiInputState& InputState);
 
 
 	//====================================================================================================
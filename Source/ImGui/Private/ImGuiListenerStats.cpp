@@ -0,0 +1,67 @@
+// Distributed under the MIT License (MIT) (see accompanying LICENSE file)
+
+#include "ImGuiPrivatePCH.h"
+
+#include "ImGuiListenerStats.h"
+
+#include "ImGuiDebugListener.h"
+#include "ImGuiDelegatesContainer.h"
+#include "ImGuiModuleProperties.h"
+
+#include <imgui.h>
+
+
+void FImGuiListenerStats::DrawControls()
+{
+	if (Properties.ShowStats())
+	{
+		ImGui::SetNextWindowSize(ImVec2(560, 240), ImGuiCond_FirstUseEver);
+		if (ImGui::Begin("ImGui Listeners"))
+		{
+			FImGuiDelegatesContainer::Get().GetListeners(Listeners);
+
+			// The most expensive listeners first.
+			Listeners.Sort([](const TSharedPtr<FImGuiDebugListener>& Lhs, const TSharedPtr<FImGuiDebugListener>& Rhs)
+			{
+				return Lhs->GetAverageTime() > Rhs->GetAverageTime();
+			});
+
+			ImGui::Columns(7, "ListenerColumns");
+			ImGui::Separator();
+			ImGui::TextUnformatted("Listener"); ImGui::NextColumn();
+			ImGui::TextUnformatted("Avg (ms)"); ImGui::NextColumn();
+			ImGui::TextUnformatted("Max (ms)"); ImGui::NextColumn();
+			ImGui::TextUnformatted("Budget (ms)"); ImGui::NextColumn();
+			ImGui::TextUnformatted("Interval"); ImGui::NextColumn();
+			ImGui::TextUnformatted("Calls"); ImGui::NextColumn();
+			ImGui::TextUnformatted("Replays"); ImGui::NextColumn();
+			ImGui::Separator();
+
+			for (const TSharedPtr<FImGuiDebugListener>& Listener : Listeners)
+			{
+				ImGui::TextUnformatted(TCHAR_TO_UTF8(*Listener->GetName().ToString())); ImGui::NextColumn();
+				ImGui::Text("%.3f", Listener->GetAverageTime()); ImGui::NextColumn();
+				ImGui::Text("%.3f", Listener->GetMaxTime()); ImGui::NextColumn();
+				if (Listener->GetOptions().Budget > 0.f)
+				{
+					ImGui::Text("%.3f", Listener->GetOptions().Budget);
+				}
+				else
+				{
+					ImGui::TextUnformatted("-");
+				}
+				ImGui::NextColumn();
+				ImGui::Text("%d", Listener->GetThrottleInterval()); ImGui::NextColumn();
+				ImGui::Text("%llu", static_cast<unsigned long long>(Listener->GetInvocationCount())); ImGui::NextColumn();
+				ImGui::Text("%llu", static_cast<unsigned long long>(Listener->GetReplayCount())); ImGui::NextColumn();
+			}
+
+			ImGui::Columns(1);
+			ImGui::Separator();
+
+			// Don't keep listeners alive after they are removed.
+			Listeners.Reset();
+		}
+		ImGui::End();
+	}
+}
@@ -0,0 +1,29 @@
+// Distributed under the MIT License (MIT) (see accompanying LICENSE file)
+
+#pragma once
+
+#include <Templates/SharedPointer.h>
+
+
+class FImGuiDebugListener;
+class FImGuiModuleProperties;
+
+// Widget drawing timing of named listeners of ImGui debug events.
+class FImGuiListenerStats
+{
+public:
+
+	FImGuiListenerStats(FImGuiModuleProperties& InProperties)
+		: Properties(InProperties)
+	{
+	}
+
+	void DrawControls();
+
+private:
+
+	FImGuiModuleProperties& Properties;
+
+	// Snapshot reused between frames to avoid allocations.
+	TArray<TSharedPtr<FImGuiDebugListener>> Listeners;
+};
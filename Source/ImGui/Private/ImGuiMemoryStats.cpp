@@ -0,0 +1,64 @@
+// Distributed under the MIT License (MIT) (see accompanying LICENSE file)
+
+#include "ImGuiPrivatePCH.h"
+
+#include "ImGuiMemoryStats.h"
+
+#include "ImGuiMemoryTracker.h"
+#include "ImGuiModuleProperties.h"
+
+#include <imgui.h>
+
+
+namespace
+{
+	void TextBytes(int64 Bytes)
+	{
+		if (Bytes < 1024)
+		{
+			ImGui::Text("%lld B", static_cast<long long>(Bytes));
+		}
+		else if (Bytes < 1024 * 1024)
+		{
+			ImGui::Text("%.1f KB", Bytes / 1024.0);
+		}
+		else
+		{
+			ImGui::Text("%.2f MB", Bytes / (1024.0 * 1024.0));
+		}
+	}
+}
+
+void FImGuiMemoryStats::DrawControls()
+{
+	if (Properties.ShowStats())
+	{
+		ImGui::SetNextWindowSize(ImVec2(480, 200), ImGuiCond_FirstUseEver);
+		if (ImGui::Begin("ImGui Memory"))
+		{
+			ImGuiMemoryTracker::GetMemoryUsage(Usage);
+
+			ImGui::Columns(5, "MemoryColumns");
+			ImGui::Separator();
+			ImGui::TextUnformatted("Owner"); ImGui::NextColumn();
+			ImGui::TextUnformatted("Live"); ImGui::NextColumn();
+			ImGui::TextUnformatted("Peak"); ImGui::NextColumn();
+			ImGui::TextUnformatted("Live Allocs"); ImGui::NextColumn();
+			ImGui::TextUnformatted("Total Allocs"); ImGui::NextColumn();
+			ImGui::Separator();
+
+			for (const FImGuiMemoryUsage& Entry : Usage)
+			{
+				ImGui::TextUnformatted(TCHAR_TO_UTF8(*Entry.Name)); ImGui::NextColumn();
+				TextBytes(Entry.LiveBytes); ImGui::NextColumn();
+				TextBytes(Entry.PeakBytes); ImGui::NextColumn();
+				ImGui::Text("%lld", static_cast<long long>(Entry.LiveAllocations)); ImGui::NextColumn();
+				ImGui::Text("%lld", static_cast<long long>(Entry.TotalAllocations)); ImGui::NextColumn();
+			}
+
+			ImGui::Columns(1);
+			ImGui::Separator();
+		}
+		ImGui::End();
+	}
+}
@@ -0,0 +1,28 @@
+// Distributed under the MIT License (MIT) (see accompanying LICENSE file)
+
+#pragma once
+
+#include "ImGuiMemoryUsage.h"
+
+
+class FImGuiModuleProperties;
+
+// Widget drawing memory allocated by ImGui contexts and shared resources.
+class FImGuiMemoryStats
+{
+public:
+
+	FImGuiMemoryStats(FImGuiModuleProperties& InProperties)
+		: Properties(InProperties)
+	{
+	}
+
+	void DrawControls();
+
+private:
+
+	FImGuiModuleProperties& Properties;
+
+	// Snapshot reused between frames to avoid allocations.
+	TArray<FImGuiMemoryUsage> Usage;
+};
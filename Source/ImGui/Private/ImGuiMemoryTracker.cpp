@@ -0,0 +1,136 @@
+// Distributed under the MIT License (MIT) (see accompanying LICENSE file)
+
+#include "ImGuiPrivatePCH.h"
+
+#include "ImGuiMemoryTracker.h"
+
+#include <imgui.h>
+
+
+namespace
+{
+	// Stored in front of every allocation. Padded to keep the default alignment of returned memory.
+	struct alignas(16) FAllocationHeader
+	{
+		FImGuiMemoryCounters* Owner;
+		SIZE_T Size;
+	};
+
+	// Owners active in each thread.
+	thread_local FImGuiMemoryCounters* CurrentOwner = nullptr;
+
+	FImGuiMemoryCounters SharedCounters{ TEXT("Shared") };
+
+	// Counters are allocated separately, so their addresses stored in allocation headers are stable.
+	TMap<FString, TUniquePtr<FImGuiMemoryCounters>>& GetRegistry()
+	{
+		static TMap<FString, TUniquePtr<FImGuiMemoryCounters>> Registry;
+		return Registry;
+	}
+
+	void UpdatePeak(FImGuiMemoryCounters& Counters, int64 LiveBytes)
+	{
+		int64 Peak = Counters.PeakBytes;
+		while (LiveBytes > Peak)
+		{
+			const int64 Previous = FPlatformAtomics::InterlockedCompareExchange(&Counters.PeakBytes, LiveBytes, Peak);
+			if (Previous == Peak)
+			{
+				break;
+			}
+			Peak = Previous;
+		}
+	}
+
+	void* Allocate(size_t Size, void* /*UserData*/)
+	{
+		FAllocationHeader* Header = static_cast<FAllocationHeader*>(FMemory::Malloc(sizeof(FAllocationHeader) + Size));
+
+		FImGuiMemoryCounters& Owner = CurrentOwner ? *CurrentOwner : SharedCounters;
+		Header->Owner = &Owner;
+		Header->Size = Size;
+
+		const int64 LiveBytes = FPlatformAtomics::InterlockedAdd(&Owner.LiveBytes, static_cast<int64>(Size)) + Size;
+		FPlatformAtomics::InterlockedIncrement(&Owner.LiveAllocations);
+		FPlatformAtomics::InterlockedIncrement(&Owner.TotalAllocations);
+		UpdatePeak(Owner, LiveBytes);
+
+		return Header + 1;
+	}
+
+	void Free(void* Ptr, void* /*UserData*/)
+	{
+		if (Ptr)
+		{
+			FAllocationHeader* Header = static_cast<FAllocationHeader*>(Ptr) - 1;
+
+			FImGuiMemoryCounters& Owner = *Header->Owner;
+			FPlatformAtomics::InterlockedAdd(&Owner.LiveBytes, -static_cast<int64>(Header->Size));
+			FPlatformAtomics::InterlockedDecrement(&Owner.LiveAllocations);
+
+			FMemory::Free(Header);
+		}
+	}
+}
+
+namespace ImGuiMemoryTracker
+{
+	void Initialize()
+	{
+		ImGui::SetAllocatorFunctions(&Allocate, &Free);
+	}
+
+	FImGuiMemoryCounters& GetCounters(const FString& OwnerName)
+	{
+		TUniquePtr<FImGuiMemoryCounters>& Counters = GetRegistry().FindOrAdd(OwnerName);
+		if (!Counters)
+		{
+			Counters = MakeUnique<FImGuiMemoryCounters>(OwnerName);
+		}
+		return *Counters;
+	}
+
+	FImGuiMemoryCounters& GetSharedCounters()
+	{
+		return SharedCounters;
+	}
+
+	FImGuiMemoryUsage GetMemoryUsage(const FImGuiMemoryCounters& Counters)
+	{
+		FImGuiMemoryUsage Usage;
+		Usage.Name = Counters.Name;
+		Usage.LiveBytes = Counters.LiveBytes;
+		Usage.PeakBytes = Counters.PeakBytes;
+		Usage.LiveAllocations = Counters.LiveAllocations;
+		Usage.TotalAllocations = Counters.TotalAllocations;
+		return Usage;
+	}
+
+	void GetMemoryUsage(TArray<FImGuiMemoryUsage>& OutUsage)
+	{
+		const auto& Registry = GetRegistry();
+
+		OutUsage.Reset(Registry.Num() + 1);
+		OutUsage.Add(GetMemoryUsage(SharedCounters));
+		for (const auto& Entry : Registry)
+		{
+			OutUsage.Add(GetMemoryUsage(*Entry.Value));
+		}
+	}
+
+	void ResetPeak(FImGuiMemoryCounters& Counters)
+	{
+		FPlatformAtomics::InterlockedExchange(&Counters.PeakBytes, Counters.LiveBytes);
+	}
+
+	FOwnerScope::FOwnerScope(FImGuiMemoryCounters& Counters)
+		: PreviousOwner(CurrentOwner)
+	{
+		CurrentOwner = &Counters;
+	}
+
+	FOwnerScope::~FOwnerScope()
+	{
+		CurrentOwner = PreviousOwner;
+	}
+}
@@ -0,0 +1,65 @@
+// Distributed under the MIT License (MIT) (see accompanying LICENSE file)
+
+#pragma once
+
+#include "ImGuiMemoryUsage.h"
+
+
+// Memory counters of a single owner. Counters are updated atomically, because ImGui can allocate on worker threads
+// (e.g. when building font atlas).
+struct FImGuiMemoryCounters
+{
+	FImGuiMemoryCounters(const FString& InName)
+		: Name(InName)
+	{
+	}
+
+	FString Name;
+
+	volatile int64 LiveBytes = 0;
+	volatile int64 PeakBytes = 0;
+	volatile int64 LiveAllocations = 0;
+	volatile int64 TotalAllocations = 0;
+};
+
+// Accounting of memory allocated by ImGui. All ImGui allocations are routed through allocator functions which attribute
+// them to the owner active in the allocating thread (or to shared counters, if there is no active owner). Owner is
+// stored with allocation, so it is correctly released, even if it happens in a different scope.
+namespace ImGuiMemoryTracker
+{
+	// Install allocator functions in ImGui. Must be called before the first ImGui allocation.
+	void Initialize();
+
+	// Get counters for owner with given name, creating them on the first call. Counters are never destroyed, so they
+	// can be reused by owners with the same name (like contexts re-created between sessions).
+	FImGuiMemoryCounters& GetCounters(const FString& OwnerName);
+
+	// Get counters for allocations made outside of any owner scope (e.g. font atlas).
+	FImGuiMemoryCounters& GetSharedCounters();
+
+	// Get a snapshot of memory usage of all owners, starting with the shared counters.
+	void GetMemoryUsage(TArray<FImGuiMemoryUsage>& OutUsage);
+
+	// Get a snapshot of memory usage of a single owner.
+	FImGuiMemoryUsage GetMemoryUsage(const FImGuiMemoryCounters& Counters);
+
+	// Reset peak of given counters to the current usage.
+	void ResetPeak(FImGuiMemoryCounters& Counters);
+
+	// Attributes ImGui allocations made in the current thread to given counters, for as long as this object is in
+	// scope. Scopes can be nested.
+	class FOwnerScope
+	{
+	public:
+
+		FOwnerScope(FImGuiMemoryCounters& Counters);
+		~FOwnerScope();
+
+		FOwnerScope(const FOwnerScope&) = delete;
+		FOwnerScope& operator=(const FOwnerScope&) = delete;
+
+	private:
+
+		FImGuiMemoryCounters* PreviousOwner;
+	};
+}
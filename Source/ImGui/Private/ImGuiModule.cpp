@@ -5,6 +5,8 @@
 #include "ImGuiModuleManager.h"
 
 #include "ImGuiDelegatesContainer.h"
+#include "ImGuiMemoryTracker.h"
+#include "ImGuiOffscreenRenderer.h"
 #include "ImGuiTextureHandle.h"
 #include "TextureManager.h"
 #include "Utilities/WorldContext.h"
@@ -15,6 +17,7 @@
 #include "Editor/ImGuiEditor.h"
 #endif
 
+#include <Engine/TextureRenderTarget2D.h>
 #include <Interfaces/IPluginManager.h>
 
 #define IMGUI_REDIRECT_OBSOLETE_DELEGATES 1
@@ -23,6 +26,9 @@
 #define LOCTEXT_NAMESPACE "FImGuiModule"
 
 
+DEFINE_LOG_CATEGORY(LogImGui);
+
+
 struct EDelegateCategory
 {
 	enum
@@ -147,8 +153,56 @@ void FImGuiModule::ReleaseTexture(const FImGuiTextureHandle& Handle)
 	}
 }
 
+void FImGuiModule::RenderOffscreenContext(const FName& ContextName, int32 Width, int32 Height, TArray<FColor>& OutPixels,
+	float DeltaSeconds)
+{
+	checkf(ImGuiModuleManager, TEXT("Null pointer to internal module implementation. Is module available?"));
+
+	// Offscreen rendering can be requested from inside of other ImGui frames, so we need to restore current context.
+	ImGuiContext* PreviousContext = ImGui::GetCurrentContext();
+
+	FImGuiContextManager& ContextManager = ImGuiModuleManager->GetContextManager();
+	FImGuiContextProxy& ContextProxy = ContextManager.GetOffscreenContextProxy(ContextName);
+
+	// Display size is read when frame begins, so after resizing we need one additional frame to have correct output.
+	const FVector2D DisplaySize{ static_cast<float>(Width), static_cast<float>(Height) };
+	if (ContextProxy.GetDisplaySize() != DisplaySize)
+	{
+		ContextProxy.SetDisplaySize(DisplaySize);
+		ContextProxy.Update(0.f);
+	}
+
+	ContextProxy.Update(DeltaSeconds);
+
+	// Without module tick (e.g. in commandlets) glyphs requested by offscreen contexts wouldn't be rasterised.
+	ContextManager.GetFontAtlas().Update();
+
+	const ImFontAtlas* FontAtlas = ContextProxy.GetDrawDataFontAtlas();
+	const bool bSignedDistanceField = FontAtlas && ContextManager.GetFontAtlas().IsSignedDistanceField(*FontAtlas);
+	ImGuiOffscreenRenderer::Rasterize(ContextProxy.GetDrawData(), FontAtlas, bSignedDistanceField, Width, Height, OutPixels);
+
+	ImGui::SetCurrentContext(PreviousContext);
+}
+
+bool FImGuiModule::RenderOffscreenContext(const FName& ContextName, UTextureRenderTarget2D* RenderTarget, float DeltaSeconds)
+{
+	checkf(RenderTarget, TEXT("Null render target passed to RenderOffscreenContext."));
+
+	TArray<FColor> Pixels;
+	RenderOffscreenContext(ContextName, RenderTarget->SizeX, RenderTarget->SizeY, Pixels, DeltaSeconds);
+	return ImGuiOffscreenRenderer::CopyToRenderTarget(Pixels, *RenderTarget);
+}
+
+void FImGuiModule::GetMemoryUsage(TArray<FImGuiMemoryUsage>& OutUsage) const
+{
+	ImGuiMemoryTracker::GetMemoryUsage(OutUsage);
+}
+
 void FImGuiModule::StartupModule()
 {
+	// Route ImGui allocations through memory tracker. This needs to happen before anything is allocated by ImGui.
+	ImGuiMemoryTracker::Initialize();
+
 	// Create managers that implements module logic.
 
 	checkf(!ImGuiModuleManager, TEXT("Instance of the ImGui Module Manager already exists. Instance should be created only during module startup."));
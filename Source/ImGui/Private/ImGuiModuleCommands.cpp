@@ -4,6 +4,7 @@
 
 #include "ImGuiModuleCommands.h"
 
+#include "ImGuiSettingsFormat.h"
 #include "Utilities/DebugExecBindings.h"
 
 
@@ -14,6 +15,8 @@ const TCHAR* const FImGuiModuleCommands::ToggleKeyboardInputSharing = TEXT("ImGu
 const TCHAR* const FImGuiModuleCommands::ToggleGamepadInputSharing = TEXT("ImGui.ToggleGamepadInputSharing");
 const TCHAR* const FImGuiModuleCommands::ToggleMouseInputSharing = TEXT("ImGui.ToggleMouseInputSharing");
 const TCHAR* const FImGuiModuleCommands::ToggleDemo = TEXT("ImGui.ToggleDemo");
+const TCHAR* const FImGuiModuleCommands::ToggleStats = TEXT("ImGui.ToggleStats");
+const TCHAR* const FImGuiModuleCommands::ConvertSettings = TEXT("ImGui.ConvertSettings");
 
 FImGuiModuleCommands::FImGuiModuleCommands(FImGuiModuleProperties& InProperties)
 	: Properties(InProperties)
@@ -38,6 +41,13 @@ FImGuiModuleCommands::FImGuiModuleCommands(FImGuiModuleProperties& InProperties)
 	, ToggleDemoCommand(ToggleDemo,
 		TEXT("Toggle ImGui demo."),
 		FConsoleCommandDelegate::CreateRaw(this, &FImGuiModuleCommands::ToggleDemoImpl))
+	, ToggleStatsCommand(ToggleStats,
+		TEXT("Toggle ImGui memory and listener stats."),
+		FConsoleCommandDelegate::CreateRaw(this, &FImGuiModuleCommands::ToggleStatsImpl))
+	, ConvertSettingsCommand(ConvertSettings,
+		TEXT("Convert ImGui settings file between ini and binary format. Argument is a file name or path.\n")
+		TEXT("Relative paths are resolved against 'Saved/ImGui'. Output is saved next to the source file."),
+		FConsoleCommandWithArgsDelegate::CreateRaw(this, &FImGuiModuleCommands::ConvertSettingsImpl))
 {
 }
 
@@ -80,3 +90,23 @@ void FImGuiModuleCommands::ToggleDemoImpl()
 {
 	Properties.ToggleDemo();
 }
+
+void FImGuiModuleCommands::ToggleStatsImpl()
+{
+	Properties.ToggleStats();
+}
+
+void FImGuiModuleCommands::ConvertSettingsImpl(const TArray<FString>& Args)
+{
+	if (Args.Num() != 1)
+	{
+		UE_LOG(LogImGui, Warning, TEXT("Usage: %s <File>"), ConvertSettings);
+		return;
+	}
+
+	FString OutFile;
+	if (ImGuiSettingsFormat::ConvertFile(Args[0], OutFile))
+	{
+		UE_LOG(LogImGui, Display, TEXT("ImGui settings converted to '%s'."), *OutFile);
+	}
+}
@@ -20,6 +20,8 @@ public:
 	static const TCHAR* const ToggleGamepadInputSharing;
 	static const TCHAR* const ToggleMouseInputSharing;
 	static const TCHAR* const ToggleDemo;
+	static const TCHAR* const ToggleStats;
+	static const TCHAR* const ConvertSettings;
 
 	FImGuiModuleCommands(FImGuiModuleProperties& InProperties);
 
@@ -34,6 +36,8 @@ private:
 	void ToggleGamepadInputSharingImpl();
 	void ToggleMouseInputSharingImpl();
 	void ToggleDemoImpl();
+	void ToggleStatsImpl();
+	void ConvertSettingsImpl(const TArray<FString>& Args);
 
 	FImGuiModuleProperties& Properties;
 
@@ -44,4 +48,6 @@ private:
 	FAutoConsoleCommand ToggleGamepadInputSharingCommand;
 	FAutoConsoleCommand ToggleMouseInputSharingCommand;
 	FAutoConsoleCommand ToggleDemoCommand;
+	FAutoConsoleCommand ToggleStatsCommand;
+	FAutoConsoleCommand ConvertSettingsCommand;
 };
@@ -12,5 +12,8 @@
 #define IMGUI_MODULE_DEVELOPER 0
 
 
+// General module logger (used to raise problems with configuration and resources).
+DECLARE_LOG_CATEGORY_EXTERN(LogImGui, Log, All);
+
 // Input Handler logger (used also in non-developer mode to raise problems with handler extensions).
 DECLARE_LOG_CATEGORY_EXTERN(LogImGuiInputHandler, Warning, All);
@@ -20,10 +20,16 @@ FImGuiModuleManager::FImGuiModuleManager()
 	: Commands(Properties)
 	, Settings(Properties, Commands)
 	, ImGuiDemo(Properties)
+	, MemoryStats(Properties)
+	, ListenerStats(Properties)
+	, ContextManager(Settings)
 {
 	// Register in context manager to get information whenever a new context proxy is created.
 	ContextManager.OnContextProxyCreated().AddRaw(this, &FImGuiModuleManager::OnContextProxyCreated);
 
+	// Apply settings that changed at runtime.
+	Settings.OnSettingsChanged.AddRaw(this, &FImGuiModuleManager::OnSettingsChanged);
+
 	// Typically we will use viewport created events to add widget to new game viewports.
 	ViewportCreatedHandle = UGameViewportClient::OnViewportCreated().AddRaw(this, &FImGuiModuleManager::OnViewportCreated);
 
@@ -43,6 +49,8 @@ FImGuiModuleManager::FImGuiModuleManager()
 
 FImGuiModuleManager::~FImGuiModuleManager()
 {
+	Settings.OnSettingsChanged.RemoveAll(this);
+
 	// We are no longer interested with adding widgets to viewports.
 	if (ViewportCreatedHandle.IsValid())
 	{
@@ -83,16 +91,119 @@ void FImGuiModuleManager::LoadTextures()
 		TextureManager.CreatePlainTexture(FName{ "ImGuiModule_Plain" }, 2, 2, FColor::White);
 
 		// Create a font atlas texture.
-		ImFontAtlas& Fonts = ContextManager.GetFontAtlas();
+		CreateFontAtlasTexture();
+	}
+}
 
-		unsigned char* Pixels;
-		int Width, Height, Bpp;
+void FImGuiModuleManager::CreateFontAtlasTexture()
+{
+	// If we have a material that can swizzle alpha-only data, we can upload font atlas as a single-channel texture,
+	// otherwise we need to convert it to RGBA.
+	FImGuiFontAtlas& FontAtlas = ContextManager.GetFontAtlas();
+
+	UMaterialInterface* FontAtlasMaterial = nullptr;
+	if (Settings.GetFontAtlasMaterial().IsValid())
+	{
+		FontAtlasMaterial = Cast<UMaterialInterface>(Settings.GetFontAtlasMaterial().TryLoad());
+		if (!FontAtlasMaterial)
+		{
+			UE_LOG(LogImGui, Warning, TEXT("Failed to load font atlas material '%s'. Using RGBA font atlas instead."),
+				*Settings.GetFontAtlasMaterial().ToString());
+		}
+	}
+
+	// Report material before getting the atlas, so if this is the first build, it doesn't bake signed distance fields
+	// that cannot be rendered without the material.
+	FontAtlas.SetUnavailableMaterial(FontAtlasMaterial ? FString{} : Settings.GetFontAtlasMaterial().ToString());
+	ImFontAtlas& Fonts = FontAtlas.Get();
+
+	unsigned char* Pixels;
+	int Width, Height, Bpp;
+	if (FontAtlasMaterial)
+	{
+		Fonts.GetTexDataAsAlpha8(&Pixels, &Width, &Height, &Bpp);
+	}
+	else
+	{
 		Fonts.GetTexDataAsRGBA32(&Pixels, &Width, &Height, &Bpp);
+	}
 
-		TextureIndex FontsTexureIndex = TextureManager.CreateTexture(FName{ "ImGuiModule_FontAtlas" }, Width, Height, Bpp, Pixels);
+	// Old atlas may still use its texture when a new one is created, so each generation needs a unique name.
+	const TextureIndex FontAtlasTextureIndex = TextureManager.CreateTexture(
+		FName{ "ImGuiModule_FontAtlas", static_cast<int32>(FontAtlas.GetGeneration()) }, Width, Height, Bpp, Pixels);
 
-		// Set font texture index in ImGui.
-		Fonts.TexID = ImGuiInterops::ToImTextureID(FontsTexureIndex);
+	if (FontAtlasMaterial)
+	{
+		TextureManager.SetTextureMaterial(FontAtlasTextureIndex, FontAtlasMaterial, FName{ "FontAtlas" });
+	}
+
+	// Set font texture index in ImGui.
+	Fonts.TexID = ImGuiInterops::ToImTextureID(FontAtlasTextureIndex);
+
+	// Whole atlas is already uploaded, so we can ignore glyphs rasterised before this point.
+	FIntRect DirtyArea;
+	FontAtlas.ConsumeDirtyArea(DirtyArea);
+}
+
+void FImGuiModuleManager::UpdateFontAtlasTexture()
+{
+	if (!bTexturesLoaded)
+	{
+		return;
+	}
+
+	FImGuiFontAtlas& FontAtlas = ContextManager.GetFontAtlas();
+	const ImFontAtlas& Fonts = FontAtlas.Get();
+
+	// Atlas without texture was rebuilt during this update, so we need to create a new texture for it.
+	FIntRect DirtyArea;
+	if (!Fonts.TexID)
+	{
+		CreateFontAtlasTexture();
+	}
+	else if (FontAtlas.ConsumeDirtyArea(DirtyArea))
+	{
+		// Texture was created from RGBA data only if that data exists.
+		const TextureIndex FontAtlasTextureIndex = ImGuiInterops::ToTextureIndex(Fonts.TexID);
+		if (Fonts.TexPixelsRGBA32)
+		{
+			TextureManager.UpdateTextureRegion(FontAtlasTextureIndex, DirtyArea, 4, Fonts.TexWidth * 4,
+				reinterpret_cast<const uint8*>(Fonts.TexPixelsRGBA32));
+		}
+		else
+		{
+			TextureManager.UpdateTextureRegion(FontAtlasTextureIndex, DirtyArea, 1, Fonts.TexWidth, Fonts.TexPixelsAlpha8);
+		}
+	}
+
+	// Release textures of atlases that are no longer used.
+	TArray<ImTextureID> UnusedTextures;
+	FontAtlas.ReleaseUnusedAtlases(UnusedTextures);
+	for (ImTextureID Texture : UnusedTextures)
+	{
+		TextureManager.ReleaseTextureResources(ImGuiInterops::ToTextureIndex(Texture));
+	}
+}
+
+void FImGuiModuleManager::OnSettingsChanged(EImGuiSettingsChange Changes)
+{
+	// Font atlas is rebuilt in background and contexts switch to it when it is ready.
+	if (EnumHasAnyFlags(Changes, EImGuiSettingsChange::Fonts))
+	{
+		ContextManager.GetFontAtlas().RequestRebuild();
+	}
+
+	// Rewrite settings, so they are converted to the new format without waiting for the next change.
+	if (EnumHasAnyFlags(Changes, EImGuiSettingsChange::SettingsFormat))
+	{
+		ContextManager.GetSettingsStorage().RequestWrite();
+	}
+
+	// Navigation inputs held under the old mapping would be released through their new slots, leaving the old ones
+	// active, so we drop them and let them be pressed again.
+	if (EnumHasAnyFlags(Changes, EImGuiSettingsChange::GamepadNavigation))
+	{
+		ContextManager.ResetGamepadNavigation();
 	}
 }
 
@@ -154,6 +265,9 @@ void FImGuiModuleManager::Tick(float DeltaSeconds)
 		// Update context manager to advance all ImGui contexts to the next frame.
 		ContextManager.Tick(DeltaSeconds);
 
+		// Upload glyphs rasterised during this update and create texture for a rebuilt font atlas.
+		UpdateFontAtlasTexture();
+
 		// Inform that we finished updating ImGui, so other subsystems can react.
 		PostImGuiUpdateEvent.Broadcast();
 	}
@@ -219,4 +333,6 @@ void FImGuiModuleManager::AddWidgetsToActiveViewports()
 void FImGuiModuleManager::OnContextProxyCreated(int32 ContextIndex, FImGuiContextProxy& ContextProxy)
 {
 	ContextProxy.OnDraw().AddLambda([this, ContextIndex]() { ImGuiDemo.DrawControls(ContextIndex); });
+	ContextProxy.OnDraw().AddLambda([this]() { MemoryStats.DrawControls(); });
+	ContextProxy.OnDraw().AddLambda([this]() { ListenerStats.DrawControls(); });
 }
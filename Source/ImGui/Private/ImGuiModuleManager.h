@@ -4,6 +4,8 @@
 
 #include "ImGuiContextManager.h"
 #include "ImGuiDemo.h"
+#include "ImGuiListenerStats.h"
+#include "ImGuiMemoryStats.h"
 #include "ImGuiModuleCommands.h"
 #include "ImGuiModuleProperties.h"
 #include "ImGuiModuleSettings.h"
@@ -47,6 +49,11 @@ private:
 
 	void LoadTextures();
 
+	void CreateFontAtlasTexture();
+	void UpdateFontAtlasTexture();
+
+	void OnSettingsChanged(EImGuiSettingsChange Changes);
+
 	bool IsTickRegistered() { return TickDelegateHandle.IsValid(); }
 	void RegisterTick();
 	void UnregisterTick();
@@ -78,6 +85,12 @@ private:
 	// Widget that we add to all created contexts to draw ImGui demo. 
 	FImGuiDemo ImGuiDemo;
 
+	// Widget that we add to all created contexts to draw memory stats.
+	FImGuiMemoryStats MemoryStats;
+
+	// Widget that we add to all created contexts to draw timing of named debug listeners.
+	FImGuiListenerStats ListenerStats;
+
 	// Manager for ImGui contexts.
 	FImGuiContextManager ContextManager;
 
@@ -4,6 +4,7 @@
 
 #include "ImGuiModuleSettings.h"
 
+#include "ImGuiInteroperability.h"
 #include "ImGuiModuleCommands.h"
 #include "ImGuiModuleProperties.h"
 
@@ -102,7 +103,28 @@ void FImGuiModuleSettings::UpdateSettings()
 		SetShareGamepadInput(SettingsObject->bShareGamepadInput);
 		SetShareMouseInput(SettingsObject->bShareMouseInput);
 		SetUseSoftwareCursor(SettingsObject->bUseSoftwareCursor);
+		SetLateLatchMousePosition(SettingsObject->bLateLatchMousePosition);
+		SetPredictMousePosition(SettingsObject->bPredictMousePosition);
+		SetGamepadNavigationMapping(SettingsObject->GamepadNavigationMapping);
+		SetFontAtlasMaterial(SettingsObject->FontAtlasMaterial);
+		SetFonts(SettingsObject->Fonts);
+		SetUseDynamicGlyphCache(SettingsObject->bUseDynamicGlyphCache);
+		SetDynamicGlyphCacheSize(SettingsObject->DynamicGlyphCacheSize);
+		SetUseSignedDistanceFieldFonts(SettingsObject->bUseSignedDistanceFieldFonts);
+		SetContextEvictionPolicy(SettingsObject->ContextEvictionPolicy);
+		SetContextEvictionDelay(SettingsObject->ContextEvictionDelay);
+		SetSettingsFormat(SettingsObject->SettingsFormat);
+		SetContextMemoryBudget(SettingsObject->ContextMemoryBudget);
 		SetToggleInputKey(SettingsObject->ToggleInput);
+
+		// Notify once, so changes to multiple settings (like fonts) are applied together and listeners don't need to
+		// recreate anything that is not affected.
+		if (PendingChanges != EImGuiSettingsChange::None)
+		{
+			const EImGuiSettingsChange Changes = PendingChanges;
+			PendingChanges = EImGuiSettingsChange::None;
+			OnSettingsChanged.Broadcast(Changes);
+		}
 	}
 }
 
@@ -111,7 +133,7 @@ void FImGuiModuleSettings::SetImGuiInputHandlerClass(const FStringClassReference
 	if (ImGuiInputHandlerClass != ClassReference)
 	{
 		ImGuiInputHandlerClass = ClassReference;
-		OnImGuiInputHandlerClassChanged.Broadcast(ClassReference);
+		PendingChanges |= EImGuiSettingsChange::InputHandlerClass;
 	}
 }
 
@@ -147,7 +169,111 @@ void FImGuiModuleSettings::SetUseSoftwareCursor(bool bUse)
 	if (bUseSoftwareCursor != bUse)
 	{
 		bUseSoftwareCursor = bUse;
-		OnUseSoftwareCursorChanged.Broadcast(bUse);
+		PendingChanges |= EImGuiSettingsChange::SoftwareCursor;
+	}
+}
+
+void FImGuiModuleSettings::SetLateLatchMousePosition(bool bLatch)
+{
+	if (bLateLatchMousePosition != bLatch)
+	{
+		bLateLatchMousePosition = bLatch;
+	}
+}
+
+void FImGuiModuleSettings::SetPredictMousePosition(bool bPredict)
+{
+	if (bPredictMousePosition != bPredict)
+	{
+		bPredictMousePosition = bPredict;
+	}
+}
+
+void FImGuiModuleSettings::SetGamepadNavigationMapping(const TArray<FImGuiNavInputMapping>& Mapping)
+{
+	if (GamepadNavigationMapping != Mapping)
+	{
+		GamepadNavigationMapping = Mapping;
+		ImGuiInterops::SetGamepadNavigationMapping(GamepadNavigationMapping);
+		PendingChanges |= EImGuiSettingsChange::GamepadNavigation;
+	}
+}
+
+void FImGuiModuleSettings::SetFontAtlasMaterial(const FStringAssetReference& MaterialReference)
+{
+	if (FontAtlasMaterial != MaterialReference)
+	{
+		FontAtlasMaterial = MaterialReference;
+		PendingChanges |= EImGuiSettingsChange::Fonts;
+	}
+}
+
+void FImGuiModuleSettings::SetFonts(const TArray<FImGuiFontConfig>& FontConfigs)
+{
+	if (Fonts != FontConfigs)
+	{
+		Fonts = FontConfigs;
+		PendingChanges |= EImGuiSettingsChange::Fonts;
+	}
+}
+
+void FImGuiModuleSettings::SetUseDynamicGlyphCache(bool bUse)
+{
+	if (bUseDynamicGlyphCache != bUse)
+	{
+		bUseDynamicGlyphCache = bUse;
+		PendingChanges |= EImGuiSettingsChange::Fonts;
+	}
+}
+
+void FImGuiModuleSettings::SetDynamicGlyphCacheSize(int32 Size)
+{
+	if (DynamicGlyphCacheSize != Size)
+	{
+		DynamicGlyphCacheSize = Size;
+		PendingChanges |= EImGuiSettingsChange::Fonts;
+	}
+}
+
+void FImGuiModuleSettings::SetUseSignedDistanceFieldFonts(bool bUse)
+{
+	if (bUseSignedDistanceFieldFonts != bUse)
+	{
+		bUseSignedDistanceFieldFonts = bUse;
+		PendingChanges |= EImGuiSettingsChange::Fonts;
+	}
+}
+
+void FImGuiModuleSettings::SetContextEvictionPolicy(EImGuiContextEvictionPolicy Policy)
+{
+	if (ContextEvictionPolicy != Policy)
+	{
+		ContextEvictionPolicy = Policy;
+	}
+}
+
+void FImGuiModuleSettings::SetContextEvictionDelay(float Delay)
+{
+	if (ContextEvictionDelay != Delay)
+	{
+		ContextEvictionDelay = Delay;
+	}
+}
+
+void FImGuiModuleSettings::SetSettingsFormat(EImGuiSettingsFormat Format)
+{
+	if (SettingsFormat != Format)
+	{
+		SettingsFormat = Format;
+		PendingChanges |= EImGuiSettingsChange::SettingsFormat;
+	}
+}
+
+void FImGuiModuleSettings::SetContextMemoryBudget(int32 Budget)
+{
+	if (ContextMemoryBudget != Budget)
+	{
+		ContextMemoryBudget = Budget;
 	}
 }
 
@@ -3,11 +3,99 @@
 #pragma once
 
 #include <Delegates/Delegate.h>
+#include <Engine/EngineTypes.h>
 #include <UObject/Object.h>
 
 #include "ImGuiModuleSettings.generated.h"
 
 
+/** Glyph ranges supported by ImGui. */
+UENUM()
+enum class EImGuiGlyphRanges : uint8
+{
+	Default,
+	Cyrillic,
+	Japanese,
+	Korean,
+	ChineseFull,
+	ChineseSimplifiedCommon,
+	Thai,
+	Vietnamese
+};
+
+/** What to do with contexts that are no longer used. */
+UENUM()
+enum class EImGuiContextEvictionPolicy : uint8
+{
+	/** Keep contexts intact, so they can be reused without any cost. */
+	Keep,
+
+	/** Release memory that is only needed when context is updated. */
+	Trim,
+
+	/** Destroy contexts (their window settings are saved to ini files). */
+	Destroy
+};
+
+/** Format in which window settings of contexts are saved. */
+UENUM()
+enum class EImGuiSettingsFormat : uint8
+{
+	/** Text format used by ImGui. */
+	Ini,
+
+	/** Compact binary format that is loaded without parsing. */
+	Binary
+};
+
+/** Configuration of a single font source in ImGui font atlas. */
+USTRUCT()
+struct FImGuiFontConfig
+{
+	GENERATED_BODY()
+
+	// Path to TTF or OTF font file. Relative paths are resolved from the project directory.
+	UPROPERTY(EditAnywhere, Category = "Font", meta = (FilePathFilter = "ttf", RelativeToGameDir))
+	FFilePath File;
+
+	// Font size in pixels.
+	UPROPERTY(EditAnywhere, Category = "Font", meta = (ClampMin = 1))
+	float Size = 13.f;
+
+	// Range of glyphs that should be loaded from this font.
+	UPROPERTY(EditAnywhere, Category = "Font")
+	EImGuiGlyphRanges GlyphRanges = EImGuiGlyphRanges::Default;
+
+	// If true, glyphs from this font are merged into the previous one. Useful to combine a base font with a font
+	// providing extra glyphs (like icons or CJK characters).
+	UPROPERTY(EditAnywhere, Category = "Font")
+	bool bMergeWithPrevious = false;
+
+	// Horizontal oversampling used to rasterise glyphs.
+	UPROPERTY(EditAnywhere, Category = "Font", AdvancedDisplay, meta = (ClampMin = 1, ClampMax = 8))
+	int32 OversampleH = 3;
+
+	// Vertical oversampling used to rasterise glyphs.
+	UPROPERTY(EditAnywhere, Category = "Font", AdvancedDisplay, meta = (ClampMin = 1, ClampMax = 8))
+	int32 OversampleV = 1;
+
+	friend bool operator==(const FImGuiFontConfig& Lhs, const FImGuiFontConfig& Rhs)
+	{
+		return Lhs.File.FilePath == Rhs.File.FilePath
+			&& Lhs.Size == Rhs.Size
+			&& Lhs.GlyphRanges == Rhs.GlyphRanges
+			&& Lhs.bMergeWithPrevious == Rhs.bMergeWithPrevious
+			&& Lhs.OversampleH == Rhs.OversampleH
+			&& Lhs.OversampleV == Rhs.OversampleV;
+	}
+
+	friend bool operator!=(const FImGuiFontConfig& Lhs, const FImGuiFontConfig& Rhs)
+	{
+		return !(Lhs == Rhs);
+	}
+};
+
+
 /**
  * Struct containing key information that can be used for key binding. Using 'Undetermined' value for modifier keys
  * means that those keys should be ignored when testing for a match.
@@ -47,6 +135,60 @@ struct FImGuiKeyInfo
 	}
 };
 
+// ImGui navigation inputs that can be mapped to gamepad keys. Values match ImGuiNavInput_ enumeration.
+UENUM()
+enum class EImGuiNavInput : uint8
+{
+	Activate,
+	Cancel,
+	Input,
+	Menu,
+	DpadLeft,
+	DpadRight,
+	DpadUp,
+	DpadDown,
+	LStickLeft,
+	LStickRight,
+	LStickUp,
+	LStickDown,
+	FocusPrev,
+	FocusNext,
+	TweakSlow,
+	TweakFast,
+	None = 0xFF
+};
+
+/**
+ * Mapping of a gamepad key to ImGui navigation input. Buttons set the navigation input. Axes set the navigation input
+ * when their value is positive and the negative navigation input when it is negative.
+ */
+USTRUCT()
+struct FImGuiNavInputMapping
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, Category = "Input")
+	FKey Key;
+
+	UPROPERTY(EditAnywhere, Category = "Input")
+	EImGuiNavInput NavInput = EImGuiNavInput::None;
+
+	UPROPERTY(EditAnywhere, Category = "Input")
+	EImGuiNavInput NegativeNavInput = EImGuiNavInput::None;
+
+	friend bool operator==(const FImGuiNavInputMapping& Lhs, const FImGuiNavInputMapping& Rhs)
+	{
+		return Lhs.Key == Rhs.Key
+			&& Lhs.NavInput == Rhs.NavInput
+			&& Lhs.NegativeNavInput == Rhs.NegativeNavInput;
+	}
+
+	friend bool operator!=(const FImGuiNavInputMapping& Lhs, const FImGuiNavInputMapping& Rhs)
+	{
+		return !(Lhs == Rhs);
+	}
+};
+
 // UObject used for loading and saving ImGui settings. To access actual settings use FImGuiModuleSettings interface.
 UCLASS(config=ImGui, defaultconfig)
 class UImGuiSettings : public UObject
@@ -95,6 +237,74 @@ protected:
 	UPROPERTY(EditAnywhere, config, Category = "Input", AdvancedDisplay)
 	bool bUseSoftwareCursor = false;
 
+	// If true, mouse position is sampled once more right before ImGui starts a new frame, so ImGui can see cursor moves
+	// that happened after the last Slate update.
+	UPROPERTY(EditAnywhere, config, Category = "Input", AdvancedDisplay)
+	bool bLateLatchMousePosition = true;
+
+	// If true, latched mouse position is extrapolated by one frame using the mouse velocity. This reduces perceived lag
+	// between hardware cursor and ImGui, at the cost of small overshoots when mouse suddenly stops.
+	UPROPERTY(EditAnywhere, config, Category = "Input", AdvancedDisplay, meta = (EditCondition = "bLateLatchMousePosition"))
+	bool bPredictMousePosition = false;
+
+	// Overrides of the default mapping of gamepad keys to ImGui navigation inputs. Mappings replace all default
+	// mappings of their keys, so a key can be unbound with a mapping to 'None' or bound to multiple inputs with multiple
+	// mappings.
+	UPROPERTY(EditAnywhere, config, Category = "Input", AdvancedDisplay)
+	TArray<FImGuiNavInputMapping> GamepadNavigationMapping;
+
+	// Material used to render ImGui output with an alpha-only font atlas. If set, font atlas is created as
+	// a single-channel texture what reduces its size and upload bandwidth by 75%. If not set, font atlas is created as
+	// a full RGBA texture.
+	// Material needs to be in 'User Interface' domain and have texture parameter named 'FontAtlas'
+	// (with 'Linear Grayscale' sampler type). It should output
+	// vertex color to Final Color and vertex color alpha multiplied by the red channel of the font atlas to Opacity.
+	// With signed distance field fonts, instead of the red channel directly, material should output its smooth step
+	// around 0.5 with a width based on the screen-space derivatives of the red channel.
+	UPROPERTY(EditAnywhere, config, Category = "Rendering", meta = (AllowedClasses = "MaterialInterface"))
+	FStringAssetReference FontAtlasMaterial;
+
+	// Fonts loaded to ImGui font atlas. If empty, then ImGui default font is used. Changes are applied at runtime,
+	// after font atlas is rebuilt in the background.
+	UPROPERTY(EditAnywhere, config, Category = "Fonts")
+	TArray<FImGuiFontConfig> Fonts;
+
+	// If true, glyphs outside of the default (Latin) range are not baked during atlas build. Instead, they are
+	// rasterised on the first use into the dynamic glyph cache. This significantly reduces startup time and atlas size
+	// for fonts with big glyph ranges, like Japanese or Chinese.
+	UPROPERTY(EditAnywhere, config, Category = "Fonts")
+	bool bUseDynamicGlyphCache = true;
+
+	// Size in pixels of a square font atlas region reserved for glyphs rasterised on demand.
+	UPROPERTY(EditAnywhere, config, Category = "Fonts", AdvancedDisplay, meta = (ClampMin = 256, ClampMax = 4096))
+	int32 DynamicGlyphCacheSize = 1024;
+
+	// If true, glyphs are baked as signed distance fields, so fonts stay sharp at any scale or canvas zoom without
+	// baking multiple sizes. Requires Font Atlas Material that can render distance fields.
+	UPROPERTY(EditAnywhere, config, Category = "Fonts")
+	bool bUseSignedDistanceFieldFonts = false;
+
+	// What to do with contexts of PIE worlds that are no longer valid, after they stay unused for Context Eviction Delay.
+	// Unused contexts are reset and reused when a PIE session with the same context index starts. Trimmed contexts
+	// re-allocate released memory during the first frame and destroyed contexts are recreated and restore their settings.
+	UPROPERTY(EditAnywhere, config, Category = "Contexts")
+	EImGuiContextEvictionPolicy ContextEvictionPolicy = EImGuiContextEvictionPolicy::Trim;
+
+	// Time in seconds after which unused contexts are evicted.
+	UPROPERTY(EditAnywhere, config, Category = "Contexts", meta = (ClampMin = 0))
+	float ContextEvictionDelay = 60.f;
+
+	// Format in which window settings of contexts are saved in 'Saved/ImGui'. Binary settings are loaded without parsing,
+	// what is faster for layouts with many windows. Settings are loaded from the most recent file in either format, so
+	// changing format doesn't lose layouts. Use 'ImGui.ConvertSettings' command to convert files between formats.
+	UPROPERTY(EditAnywhere, config, Category = "Contexts")
+	EImGuiSettingsFormat SettingsFormat = EImGuiSettingsFormat::Ini;
+
+	// Soft limit in kilobytes for memory allocated by ImGui on behalf of a single context. When a context exceeds it,
+	// storage of its inactive windows is released. Zero means no limit.
+	UPROPERTY(EditAnywhere, config, Category = "Contexts", meta = (ClampMin = 0))
+	int32 ContextMemoryBudget = 0;
+
 	// Define a shortcut key to 'ImGui.ToggleInput' command. Binding is only set if the key field is valid.
 	// Note that modifier key properties can be set to one of the three values: undetermined means that state of the given
 	// modifier is not important, checked means that it needs to be pressed and unchecked means that it cannot be pressed.
@@ -113,6 +323,21 @@ protected:
 };
 
 
+// Groups of settings that need to be actively applied when changed, used to tell listeners what changed in a single
+// notification. Settings that are not listed here are read every frame and they are applied without notification.
+enum class EImGuiSettingsChange : uint32
+{
+	None				= 0,
+	InputHandlerClass	= 1 << 0,
+	SoftwareCursor		= 1 << 1,
+	Fonts				= 1 << 2,
+	SettingsFormat		= 1 << 3,
+	GamepadNavigation	= 1 << 4,
+};
+
+ENUM_CLASS_FLAGS(EImGuiSettingsChange);
+
+
 class FImGuiModuleCommands;
 class FImGuiModuleProperties;
 
@@ -123,9 +348,8 @@ class FImGuiModuleSettings
 {
 public:
 
-	// Generic delegate used to notify changes of boolean properties.
-	DECLARE_MULTICAST_DELEGATE_OneParam(FBoolChangeDelegate, bool);
-	DECLARE_MULTICAST_DELEGATE_OneParam(FStringClassReferenceChangeDelegate, const FStringClassReference&);
+	// Delegate used to notify about groups of settings changed in a single update.
+	DECLARE_MULTICAST_DELEGATE_OneParam(FSettingsChangeDelegate, EImGuiSettingsChange);
 
 	// Constructor for ImGui module settings. It will bind to instances of module properties and commands and will
 	// update them every time when settings are changed.
@@ -145,14 +369,48 @@ public:
 	// Get the software cursor configuration.
 	bool UseSoftwareCursor() const { return bUseSoftwareCursor; }
 
+	// Get whether mouse position should be sampled right before ImGui starts a new frame.
+	bool LateLatchMousePosition() const { return bLateLatchMousePosition; }
+
+	// Get whether latched mouse position should be extrapolated.
+	bool PredictMousePosition() const { return bLateLatchMousePosition && bPredictMousePosition; }
+
+	// Get the path to material used to render alpha-only font atlas.
+	const FStringAssetReference& GetFontAtlasMaterial() const { return FontAtlasMaterial; }
+
+	// Get the configuration of fonts loaded to ImGui font atlas.
+	const TArray<FImGuiFontConfig>& GetFonts() const { return Fonts; }
+
+	// Whether glyphs outside of the default range should be rasterised on demand.
+	bool UseDynamicGlyphCache() const { return bUseDynamicGlyphCache; }
+
+	// Get the size of a font atlas region reserved for glyphs rasterised on demand.
+	int32 GetDynamicGlyphCacheSize() const { return DynamicGlyphCacheSize; }
+
+	// Whether glyphs should be baked as signed distance fields.
+	bool UseSignedDistanceFieldFonts() const { return bUseSignedDistanceFieldFonts; }
+
+	// Get the policy defining what to do with contexts that are no longer used.
+	EImGuiContextEvictionPolicy GetContextEvictionPolicy() const { return ContextEvictionPolicy; }
+
+	// Get the time in seconds after which unused contexts are evicted.
+	float GetContextEvictionDelay() const { return ContextEvictionDelay; }
+
+	// Get the format in which window settings of contexts are saved.
+	EImGuiSettingsFormat GetSettingsFormat() const { return SettingsFormat; }
+
+	// Get the soft limit in bytes for memory allocated by a single context (zero means no limit).
+	int64 GetContextMemoryBudget() const { return static_cast<int64>(ContextMemoryBudget) * 1024; }
+
+	// Get the overrides of the default mapping of gamepad keys to navigation inputs.
+	const TArray<FImGuiNavInputMapping>& GetGamepadNavigationMapping() const { return GamepadNavigationMapping; }
+
 	// Get the shortcut configuration for 'ImGui.ToggleInput' command.
 	const FImGuiKeyInfo& GetToggleInputKey() const { return ToggleInputKey; }
 
-	// Delegate raised when ImGui Input Handle is changed.
-	FStringClassReferenceChangeDelegate OnImGuiInputHandlerClassChanged;
-
-	// Delegate raised when software cursor configuration is changed.
-	FBoolChangeDelegate OnUseSoftwareCursorChanged;
+	// Delegate raised once after settings are updated, with all groups of settings that changed. Settings are applied
+	// before it is raised, so listeners can read them with getters and update only what is affected by changes.
+	FSettingsChangeDelegate OnSettingsChanged;
 
 private:
 
@@ -163,6 +421,18 @@ private:
 	void SetShareGamepadInput(bool bShare);
 	void SetShareMouseInput(bool bShare);
 	void SetUseSoftwareCursor(bool bUse);
+	void SetLateLatchMousePosition(bool bLatch);
+	void SetPredictMousePosition(bool bPredict);
+	void SetGamepadNavigationMapping(const TArray<FImGuiNavInputMapping>& Mapping);
+	void SetFontAtlasMaterial(const FStringAssetReference& MaterialReference);
+	void SetFonts(const TArray<FImGuiFontConfig>& FontConfigs);
+	void SetUseDynamicGlyphCache(bool bUse);
+	void SetDynamicGlyphCacheSize(int32 Size);
+	void SetUseSignedDistanceFieldFonts(bool bUse);
+	void SetContextEvictionPolicy(EImGuiContextEvictionPolicy Policy);
+	void SetContextEvictionDelay(float Delay);
+	void SetSettingsFormat(EImGuiSettingsFormat Format);
+	void SetContextMemoryBudget(int32 Budget);
 	void SetToggleInputKey(const FImGuiKeyInfo& KeyInfo);
 
 #if WITH_EDITOR
@@ -173,9 +443,24 @@ private:
 	FImGuiModuleCommands& Commands;
 
 	FStringClassReference ImGuiInputHandlerClass;
+	FStringAssetReference FontAtlasMaterial;
+	TArray<FImGuiFontConfig> Fonts;
+	TArray<FImGuiNavInputMapping> GamepadNavigationMapping;
 	FImGuiKeyInfo ToggleInputKey;
 	bool bShareKeyboardInput = false;
 	bool bShareGamepadInput = false;
 	bool bShareMouseInput = false;
 	bool bUseSoftwareCursor = false;
+	bool bLateLatchMousePosition = true;
+	bool bPredictMousePosition = false;
+	bool bUseDynamicGlyphCache = true;
+	int32 DynamicGlyphCacheSize = 1024;
+	bool bUseSignedDistanceFieldFonts = false;
+	EImGuiContextEvictionPolicy ContextEvictionPolicy = EImGuiContextEvictionPolicy::Trim;
+	float ContextEvictionDelay = 60.f;
+	EImGuiSettingsFormat SettingsFormat = EImGuiSettingsFormat::Ini;
+	int32 ContextMemoryBudget = 0;
+
+	// Changes collected during update and broadcast after all settings are applied.
+	EImGuiSettingsChange PendingChanges = EImGuiSettingsChange::None;
 };
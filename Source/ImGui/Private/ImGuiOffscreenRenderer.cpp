@@ -0,0 +1,201 @@
+// Distributed under the MIT License (MIT) (see accompanying LICENSE file)
+
+#include "ImGuiPrivatePCH.h"
+
+#include "ImGuiOffscreenRenderer.h"
+
+#include "ImGuiImplementation.h"
+
+#include <Engine/TextureRenderTarget2D.h>
+#include <RenderingThread.h>
+#include <RHI.h>
+
+
+namespace
+{
+	FORCEINLINE float EdgeFunction(const ImVec2& A, const ImVec2& B, float X, float Y)
+	{
+		return (B.x - A.x) * (Y - A.y) - (B.y - A.y) * (X - A.x);
+	}
+
+	FORCEINLINE FLinearColor UnpackColor(ImU32 Color)
+	{
+		// ImGui colors are packed as 0xAABBGGRR.
+		return FLinearColor{
+			static_cast<float>((Color >> IM_COL32_R_SHIFT) & 0xFF),
+			static_cast<float>((Color >> IM_COL32_G_SHIFT) & 0xFF),
+			static_cast<float>((Color >> IM_COL32_B_SHIFT) & 0xFF),
+			static_cast<float>((Color >> IM_COL32_A_SHIFT) & 0xFF) };
+	}
+
+	FORCEINLINE float SampleAlpha(const ImFontAtlas& FontAtlas, float U, float V)
+	{
+		const int32 X = FMath::Clamp(static_cast<int32>(U * FontAtlas.TexWidth), 0, FontAtlas.TexWidth - 1);
+		const int32 Y = FMath::Clamp(static_cast<int32>(V * FontAtlas.TexHeight), 0, FontAtlas.TexHeight - 1);
+		return FontAtlas.TexPixelsAlpha8[Y * FontAtlas.TexWidth + X];
+	}
+
+	// Blend colour with 8-bit channels over destination pixel.
+	FORCEINLINE void BlendPixel(FColor& Dst, const FLinearColor& Src)
+	{
+		const float SrcAlpha = Src.A / 255.f;
+		const float DstWeight = (Dst.A / 255.f) * (1.f - SrcAlpha);
+		const float OutAlpha = SrcAlpha + DstWeight;
+		if (OutAlpha <= 0.f)
+		{
+			return;
+		}
+
+		auto Blend = [&](float SrcChannel, uint8 DstChannel)
+		{
+			return static_cast<uint8>(FMath::Clamp((SrcChannel * SrcAlpha + DstChannel * DstWeight) / OutAlpha + 0.5f, 0.f, 255.f));
+		};
+
+		Dst.R = Blend(Src.R, Dst.R);
+		Dst.G = Blend(Src.G, Dst.G);
+		Dst.B = Blend(Src.B, Dst.B);
+		Dst.A = static_cast<uint8>(FMath::Clamp(OutAlpha * 255.f + 0.5f, 0.f, 255.f));
+	}
+
+	void RasterizeTriangle(const ImDrawVert& A, const ImDrawVert& B, const ImDrawVert& C, const FIntRect& ClipRect,
+		const ImFontAtlas* FontAtlas, bool bSignedDistanceField, int32 Width, TArray<FColor>& Pixels)
+	{
+		const float Area = EdgeFunction(A.pos, B.pos, C.pos.x, C.pos.y);
+		if (Area == 0.f)
+		{
+			return;
+		}
+
+		// Bounding box of the triangle limited to the clipping rectangle.
+		const int32 MinX = FMath::Max(ClipRect.Min.X, FMath::FloorToInt(FMath::Min3(A.pos.x, B.pos.x, C.pos.x)));
+		const int32 MinY = FMath::Max(ClipRect.Min.Y, FMath::FloorToInt(FMath::Min3(A.pos.y, B.pos.y, C.pos.y)));
+		const int32 MaxX = FMath::Min(ClipRect.Max.X, FMath::CeilToInt(FMath::Max3(A.pos.x, B.pos.x, C.pos.x)));
+		const int32 MaxY = FMath::Min(ClipRect.Max.Y, FMath::CeilToInt(FMath::Max3(A.pos.y, B.pos.y, C.pos.y)));
+
+		const FLinearColor ColorA = UnpackColor(A.col);
+		const FLinearColor ColorB = UnpackColor(B.col);
+		const FLinearColor ColorC = UnpackColor(C.col);
+
+		// Dividing by signed area gives positive weights inside of the triangle, regardless of its winding.
+		const float InvArea = 1.f / Area;
+
+		// Signed distance fields are converted to coverage with a smooth step around the edge, like in the material.
+		// Its width is one screen pixel, converted to distance using the ratio of texture and screen triangle areas.
+		float EdgeWidth = 0.f;
+		if (FontAtlas && bSignedDistanceField)
+		{
+			const ImVec2 TexelA{ A.uv.x * FontAtlas->TexWidth, A.uv.y * FontAtlas->TexHeight };
+			const ImVec2 TexelB{ B.uv.x * FontAtlas->TexWidth, B.uv.y * FontAtlas->TexHeight };
+			const float TexelArea = EdgeFunction(TexelA, TexelB, C.uv.x * FontAtlas->TexWidth, C.uv.y * FontAtlas->TexHeight);
+			const float TexelsPerPixel = FMath::Sqrt(FMath::Abs(TexelArea * InvArea));
+
+			// Distance changes by 0.5 over the padding range.
+			EdgeWidth = TexelsPerPixel * 0.5f / ImGuiImplementation::SIGNED_DISTANCE_FIELD_PADDING;
+		}
+
+		for (int32 Y = MinY; Y < MaxY; Y++)
+		{
+			for (int32 X = MinX; X < MaxX; X++)
+			{
+				// Sample at the pixel centre.
+				const float PX = X + 0.5f, PY = Y + 0.5f;
+				const float WeightA = EdgeFunction(B.pos, C.pos, PX, PY) * InvArea;
+				const float WeightB = EdgeFunction(C.pos, A.pos, PX, PY) * InvArea;
+				const float WeightC = 1.f - WeightA - WeightB;
+				if (WeightA < 0.f || WeightB < 0.f || WeightC < 0.f)
+				{
+					continue;
+				}
+
+				FLinearColor Color = ColorA * WeightA + ColorB * WeightB + ColorC * WeightC;
+				if (FontAtlas)
+				{
+					const float U = A.uv.x * WeightA + B.uv.x * WeightB + C.uv.x * WeightC;
+					const float V = A.uv.y * WeightA + B.uv.y * WeightB + C.uv.y * WeightC;
+					float Alpha = SampleAlpha(*FontAtlas, U, V) / 255.f;
+					if (bSignedDistanceField)
+					{
+						Alpha = (EdgeWidth > 0.f) ? FMath::SmoothStep(0.5f - EdgeWidth * 0.5f, 0.5f + EdgeWidth * 0.5f, Alpha)
+							: (Alpha >= 0.5f ? 1.f : 0.f);
+					}
+					Color.A *= Alpha;
+				}
+
+				BlendPixel(Pixels[Y * Width + X], Color);
+			}
+		}
+	}
+}
+
+namespace ImGuiOffscreenRenderer
+{
+	void Rasterize(const TArray<FImGuiDrawList>& DrawLists, const ImFontAtlas* FontAtlas, bool bSignedDistanceField,
+		int32 Width, int32 Height, TArray<FColor>& OutPixels)
+	{
+		OutPixels.Reset(Width * Height);
+		OutPixels.AddZeroed(Width * Height);
+
+		const bool bCanSampleFontAtlas = FontAtlas && FontAtlas->TexPixelsAlpha8;
+
+		for (const FImGuiDrawList& DrawList : DrawLists)
+		{
+			const ImVector<ImDrawIdx>& Indices = DrawList.GetImGuiIndices();
+			const ImVector<ImDrawVert>& Vertices = DrawList.GetImGuiVertices();
+
+			// Commands consume indices in order.
+			int IndexOffset = 0;
+			for (const ImDrawCmd& Command : DrawList.GetImGuiCommands())
+			{
+				const FIntRect ClipRect{
+					FMath::Max(0, FMath::FloorToInt(Command.ClipRect.x)),
+					FMath::Max(0, FMath::FloorToInt(Command.ClipRect.y)),
+					FMath::Min(Width, FMath::CeilToInt(Command.ClipRect.z)),
+					FMath::Min(Height, FMath::CeilToInt(Command.ClipRect.w)) };
+
+				// ImGui renders untextured shapes using white pixel from font atlas, so font atlas covers almost
+				// everything.
+				const ImFontAtlas* SampledAtlas = (bCanSampleFontAtlas && Command.TextureId == FontAtlas->TexID) ? FontAtlas : nullptr;
+
+				if (!Command.UserCallback && ClipRect.Min.X < ClipRect.Max.X && ClipRect.Min.Y < ClipRect.Max.Y)
+				{
+					for (unsigned int Index = 0; Index + 2 < Command.ElemCount; Index += 3)
+					{
+						const int First = IndexOffset + Index;
+						RasterizeTriangle(Vertices[Indices[First]], Vertices[Indices[First + 1]], Vertices[Indices[First + 2]],
+							ClipRect, SampledAtlas, bSignedDistanceField, Width, OutPixels);
+					}
+				}
+
+				IndexOffset += Command.ElemCount;
+			}
+		}
+	}
+
+	bool CopyToRenderTarget(const TArray<FColor>& Pixels, UTextureRenderTarget2D& RenderTarget)
+	{
+		const int32 Width = RenderTarget.SizeX;
+		const int32 Height = RenderTarget.SizeY;
+
+		FTextureRenderTargetResource* Resource = RenderTarget.GameThread_GetRenderTargetResource();
+		if (!Resource || RenderTarget.GetFormat() != PF_B8G8R8A8 || Pixels.Num() != Width * Height)
+		{
+			UE_LOG(LogImGui, Warning, TEXT("Cannot copy ImGui output to render target '%s'. Render target needs to be initialised with RGBA8 format and match the output size."),
+				*RenderTarget.GetName());
+			return false;
+		}
+
+#if ENGINE_COMPATIBILITY_WITH_RENDER_COMMAND_LAMBDAS
+		ENQUEUE_RENDER_COMMAND(ImGuiCopyToRenderTarget)(
+			[Resource, Pixels, Width, Height](FRHICommandListImmediate& RHICmdList)
+			{
+				const FUpdateTextureRegion2D Region{ 0, 0, 0, 0, static_cast<uint32>(Width), static_cast<uint32>(Height) };
+				RHIUpdateTexture2D(Resource->GetRenderTargetTexture(), 0, Region, Width * sizeof(FColor),
+					reinterpret_cast<const uint8*>(Pixels.GetData()));
+			});
+		return true;
+#else
+		UE_LOG(LogImGui, Warning, TEXT("Rendering ImGui output to render targets is not supported in this engine version."));
+		return false;
+#endif
+	}
+}
@@ -0,0 +1,32 @@
+// Distributed under the MIT License (MIT) (see accompanying LICENSE file)
+
+#pragma once
+
+#include "ImGuiDrawData.h"
+
+#include <imgui.h>
+
+
+class UTextureRenderTarget2D;
+
+// Rendering of ImGui output without Slate and game viewports. Used by offscreen contexts, so they can produce output
+// also in dedicated servers, commandlets and tests.
+namespace ImGuiOffscreenRenderer
+{
+	// Rasterise draw lists on CPU. Only font atlas is sampled, commands using other textures are rendered as if the texture
+	// was white. Output is alpha-blended over a transparent background.
+	// @param DrawLists - Draw lists to rasterise
+	// @param FontAtlas - Font atlas used to generate draw lists (can be null, if it shouldn't be sampled)
+	// @param bSignedDistanceField - Whether font atlas contains signed distance fields instead of coverage
+	// @param Width - Width of the output in pixels
+	// @param Height - Height of the output in pixels
+	// @param OutPixels - Output buffer of Width x Height pixels in rows from top to bottom
+	void Rasterize(const TArray<FImGuiDrawList>& DrawLists, const ImFontAtlas* FontAtlas, bool bSignedDistanceField,
+		int32 Width, int32 Height, TArray<FColor>& OutPixels);
+
+	// Copy pixels to a render target. Copy is done on the render thread.
+	// @param Pixels - Pixels to copy, it needs to match the size of the render target
+	// @param RenderTarget - Destination render target (needs to be in RGBA8 format)
+	// @returns True, if copy was enqueued
+	bool CopyToRenderTarget(const TArray<FColor>& Pixels, UTextureRenderTarget2D& RenderTarget);
+}
@@ -0,0 +1,236 @@
+// Distributed under the MIT License (MIT) (see accompanying LICENSE file)
+
+#include "ImGuiPrivatePCH.h"
+
+#include "ImGuiRetainedOutput.h"
+
+#include <imgui_internal.h>
+
+
+namespace
+{
+	FORCEINLINE bool IsActiveInThisFrame(const ImGuiWindow& Window)
+	{
+		return Window.LastFrameActive == ImGui::GetFrameCount();
+	}
+
+	FORCEINLINE bool IsRetainable(const ImGuiWindow& Window)
+	{
+		return !(Window.Flags & (ImGuiWindowFlags_ChildWindow | ImGuiWindowFlags_Tooltip | ImGuiWindowFlags_Popup));
+	}
+
+	// Append output of visible child windows to the output of their root window, in the same order in which ImGui
+	// renders them. Child windows are not replayed on their own, so their geometry must be a part of the root output.
+	// Returns false, if combined output doesn't fit in a single draw list.
+	bool AppendChildWindows(const ImGuiWindow& Window, ImVector<ImDrawCmd>& Commands, ImVector<ImDrawIdx>& Indices,
+		ImVector<ImDrawVert>& Vertices)
+	{
+		// Our renderer doesn't support vertex offsets, so indices in all commands are relative to the start of the list.
+		constexpr int64 MaxVertices = static_cast<int64>(TNumericLimits<ImDrawIdx>::Max()) + 1;
+
+		for (const ImGuiWindow* Child : Window.DC.ChildWindows)
+		{
+			// Same condition that ImGui uses when adding child windows to draw data. Child menus are popups, which we
+			// don't retain.
+			if (!Child->Active || Child->Hidden || (Child->Flags & (ImGuiWindowFlags_Popup | ImGuiWindowFlags_Tooltip)))
+			{
+				continue;
+			}
+
+			const ImDrawList& DrawList = *Child->DrawList;
+			if (static_cast<int64>(Vertices.Size) + DrawList.VtxBuffer.Size > MaxVertices)
+			{
+				return false;
+			}
+
+			const int VertexBase = Vertices.Size;
+			const int IndexBase = Indices.Size;
+
+			for (const ImDrawCmd& Command : DrawList.CmdBuffer)
+			{
+				if (Command.ElemCount > 0 || Command.UserCallback)
+				{
+					Commands.push_back(Command);
+					Commands.back().IdxOffset += IndexBase;
+				}
+			}
+
+			Indices.reserve(IndexBase + DrawList.IdxBuffer.Size);
+			for (const ImDrawIdx Index : DrawList.IdxBuffer)
+			{
+				Indices.push_back(static_cast<ImDrawIdx>(Index + VertexBase));
+			}
+
+			Vertices.reserve(VertexBase + DrawList.VtxBuffer.Size);
+			for (const ImDrawVert& Vertex : DrawList.VtxBuffer)
+			{
+				Vertices.push_back(Vertex);
+			}
+
+			if (!AppendChildWindows(*Child, Commands, Indices, Vertices))
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+}
+
+bool FImGuiRetainedOutput::IsReusable(uint64 InVersion) const
+{
+	if (!bHasVersion || Version != InVersion || Windows.Num() == 0 || bDroppedWindows || bRecordedInteraction
+		|| IsInteracting())
+	{
+		return false;
+	}
+
+	for (const FWindowOutput& Output : Windows)
+	{
+		if (!ImGui::FindWindowByID(Output.Id))
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+void FImGuiRetainedOutput::BeginRecording()
+{
+	bHasVersion = false;
+
+	ActiveWindows.Reset();
+	for (const ImGuiWindow* Window : ImGui::GetCurrentContext()->Windows)
+	{
+		if (IsActiveInThisFrame(*Window))
+		{
+			ActiveWindows.Add(Window->ID);
+		}
+	}
+}
+
+void FImGuiRetainedOutput::EndRecording()
+{
+	Windows.Reset();
+	bDroppedWindows = false;
+	for (const ImGuiWindow* Window : ImGui::GetCurrentContext()->Windows)
+	{
+		if (IsActiveInThisFrame(*Window) && IsRetainable(*Window) && !ActiveWindows.Contains(Window->ID))
+		{
+			FWindowOutput& Output = Windows.AddDefaulted_GetRef();
+			Output.Id = Window->ID;
+			Output.Flags = Window->Flags;
+			Output.Pos = Window->Pos;
+			Output.ContentSize = ImVec2{ Window->DC.CursorMaxPos.x - Window->DC.CursorStartPos.x,
+				Window->DC.CursorMaxPos.y - Window->DC.CursorStartPos.y };
+			Output.Commands = Window->DrawList->CmdBuffer;
+			Output.Indices = Window->DrawList->IdxBuffer;
+			Output.Vertices = Window->DrawList->VtxBuffer;
+
+			// Windows whose output cannot be retained as a whole are dropped, rather than replayed with empty regions.
+			if (!AppendChildWindows(*Window, Output.Commands, Output.Indices, Output.Vertices))
+			{
+				Windows.Pop(false);
+				bDroppedWindows = true;
+			}
+		}
+	}
+	ActiveWindows.Reset();
+
+	bRecordedInteraction = IsInteracting();
+}
+
+bool FImGuiRetainedOutput::IsInteracting() const
+{
+	const ImGuiContext& Context = *ImGui::GetCurrentContext();
+
+	auto IsRetained = [this](const ImGuiWindow* Window)
+	{
+		return Window && Windows.ContainsByPredicate([Window](const FWindowOutput& Output)
+		{
+			return Output.Id == Window->RootWindow->ID;
+		});
+	};
+
+	if (IsRetained(Context.HoveredRootWindow) || IsRetained(Context.ActiveIdWindow))
+	{
+		return true;
+	}
+
+	if (IsRetained(Context.NavWindow))
+	{
+		const ImGuiIO& IO = Context.IO;
+		if (IO.InputQueueCharacters.Size > 0)
+		{
+			return true;
+		}
+
+		for (const bool bKeyDown : IO.KeysDown)
+		{
+			if (bKeyDown)
+			{
+				return true;
+			}
+		}
+
+		for (const float NavInput : IO.NavInputs)
+		{
+			if (NavInput > 0.f)
+			{
+				return true;
+			}
+		}
+	}
+
+	return false;
+}
+
+void FImGuiRetainedOutput::Replay()
+{
+	for (const FWindowOutput& Output : Windows)
+	{
+		ImGuiWindow* Window = ImGui::FindWindowByID(Output.Id);
+		if (!Window || IsActiveInThisFrame(*Window))
+		{
+			continue;
+		}
+
+		// Begin fills the draw list with decorations, which we replace with the stored output. Window could be moved
+		// since recording, so stored geometry is offset by the difference.
+		if (ImGui::Begin(Window->Name, nullptr, Output.Flags))
+		{
+			const ImVec2 Offset{ Window->Pos.x - Output.Pos.x, Window->Pos.y - Output.Pos.y };
+
+			ImDrawList& DrawList = *Window->DrawList;
+			DrawList.CmdBuffer = Output.Commands;
+			DrawList.IdxBuffer = Output.Indices;
+			DrawList.VtxBuffer = Output.Vertices;
+
+			for (ImDrawCmd& Command : DrawList.CmdBuffer)
+			{
+				Command.ClipRect.x += Offset.x;
+				Command.ClipRect.y += Offset.y;
+				Command.ClipRect.z += Offset.x;
+				Command.ClipRect.w += Offset.y;
+			}
+
+			for (ImDrawVert& Vertex : DrawList.VtxBuffer)
+			{
+				Vertex.pos.x += Offset.x;
+				Vertex.pos.y += Offset.y;
+			}
+
+			// Restore write state, so draw list can be safely appended while closing the window.
+			DrawList._VtxCurrentOffset = DrawList.CmdBuffer.Size > 0 ? DrawList.CmdBuffer.back().VtxOffset : 0;
+			DrawList._VtxCurrentIdx = DrawList.VtxBuffer.Size - DrawList._VtxCurrentOffset;
+			DrawList._VtxWritePtr = DrawList.VtxBuffer.Data + DrawList.VtxBuffer.Size;
+			DrawList._IdxWritePtr = DrawList.IdxBuffer.Data + DrawList.IdxBuffer.Size;
+
+			// Keep content size, so auto-resizing and scrollbars behave like in recorded frames.
+			Window->DC.CursorMaxPos = ImVec2{ Window->DC.CursorStartPos.x + Output.ContentSize.x,
+				Window->DC.CursorStartPos.y + Output.ContentSize.y };
+		}
+		ImGui::End();
+	}
+}
@@ -0,0 +1,71 @@
+// Distributed under the MIT License (MIT) (see accompanying LICENSE file)
+
+#pragma once
+
+#include <CoreMinimal.h>
+
+#include <imgui.h>
+
+
+// Output of ImGui windows drawn during a single listener invocation. It can be replayed in frames in which listener is
+// not invoked, so windows of listeners that run every N frames don't disappear or flicker. Replayed windows keep their
+// position, size and scrolling but don't process input. Output of child windows is retained as a part of their root
+// window, but popups and tooltips are not retained.
+class FImGuiRetainedOutput
+{
+public:
+
+	// Start recording windows in the current context. Must be followed by EndRecording in the same frame.
+	void BeginRecording();
+
+	// Finish recording and store output of all top-level windows that were submitted since BeginRecording, together
+	// with output of their child windows.
+	void EndRecording();
+
+	// Redraw stored windows in the current context, skipping those that were already submitted in this frame.
+	void Replay();
+
+	// Release stored output.
+	void Reset() { Windows.Empty(); bHasVersion = false; bDroppedWindows = false; }
+
+	// Whether there is any stored output.
+	bool IsEmpty() const { return Windows.Num() == 0; }
+
+	// Set the version of data drawn in the recorded output.
+	void SetVersion(uint64 InVersion) { Version = InVersion; bHasVersion = true; }
+
+	// Check whether stored output was recorded with given data version and can be replayed instead of redrawing.
+	// Output is not reusable if any of its windows is missing or is interacted with in this or the recorded frame, so
+	// widgets stay responsive and don't keep hover or active states after interaction ends. It is also not reusable if
+	// any of the recorded windows couldn't be retained, so replay doesn't hide it for as long as the version is unchanged.
+	bool IsReusable(uint64 InVersion) const;
+
+private:
+
+	bool IsInteracting() const;
+
+	struct FWindowOutput
+	{
+		ImGuiID Id;
+		ImGuiWindowFlags Flags;
+		ImVec2 Pos;
+		ImVec2 ContentSize;
+		ImVector<ImDrawCmd> Commands;
+		ImVector<ImDrawIdx> Indices;
+		ImVector<ImDrawVert> Vertices;
+	};
+
+	TArray<FWindowOutput> Windows;
+
+	// Windows that were already active when recording started.
+	TArray<ImGuiID> ActiveWindows;
+
+	uint64 Version = 0;
+	bool bHasVersion = false;
+
+	// Whether windows were interacted with when output was recorded.
+	bool bRecordedInteraction = false;
+
+	// Whether any of the windows submitted during recording couldn't be retained.
+	bool bDroppedWindows = false;
+};
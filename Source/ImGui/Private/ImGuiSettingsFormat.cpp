@@ -0,0 +1,403 @@
+// Distributed under the MIT License (MIT) (see accompanying LICENSE file)
+
+#include "ImGuiPrivatePCH.h"
+
+#include "ImGuiSettingsFormat.h"
+
+#include "Utilities/Paths.h"
+
+#include <Misc/FileHelper.h>
+#include <Serialization/BufferReader.h>
+#include <Serialization/MemoryWriter.h>
+
+#include <imgui_internal.h>
+
+
+namespace
+{
+	constexpr uint32 BINARY_MAGIC = 0x53474D49; // IMGS
+	constexpr uint32 BINARY_VERSION = 1;
+
+	// Header: magic, version and number of windows.
+	constexpr int64 HEADER_SIZE = 3 * sizeof(uint32);
+
+	// Window record: id, position, size, collapsed flag, reserved byte, name length and name offset.
+	constexpr int64 RECORD_SIZE = sizeof(uint32) + 4 * sizeof(int16) + 2 * sizeof(uint8) + sizeof(uint16) + sizeof(uint32);
+
+	const char* const WINDOW_SECTION = "Window";
+
+	struct FWindowRecord
+	{
+		uint32 Id = 0;
+		int16 PosX = 0;
+		int16 PosY = 0;
+		int16 SizeX = 0;
+		int16 SizeY = 0;
+		uint8 bCollapsed = 0;
+		uint8 Reserved = 0;
+		uint16 NameLength = 0;
+		uint32 NameOffset = 0;
+
+		friend FArchive& operator<<(FArchive& Ar, FWindowRecord& Record)
+		{
+			return Ar << Record.Id << Record.PosX << Record.PosY << Record.SizeX << Record.SizeY << Record.bCollapsed
+				<< Record.Reserved << Record.NameLength << Record.NameOffset;
+		}
+	};
+
+	// Binary settings decoded without copying names and extra settings.
+	struct FBinaryView
+	{
+		TArray<FWindowRecord> Windows;
+		const char* Names = nullptr;
+		int32 NamesSize = 0;
+		const char* Extra = nullptr;
+		int32 ExtraSize = 0;
+
+		const char* GetName(const FWindowRecord& Record) const { return Names + Record.NameOffset; }
+	};
+
+	bool ReadBinary(const TArray<uint8>& Binary, FBinaryView& OutView)
+	{
+		FBufferReader Reader{ const_cast<uint8*>(Binary.GetData()), Binary.Num(), false };
+
+		uint32 Magic = 0, Version = 0;
+		int32 NumWindows = 0;
+		Reader << Magic << Version << NumWindows;
+		if (Reader.IsError() || Magic != BINARY_MAGIC || Version != BINARY_VERSION || NumWindows < 0
+			|| HEADER_SIZE + NumWindows * RECORD_SIZE > Binary.Num())
+		{
+			return false;
+		}
+
+		OutView.Windows.SetNum(NumWindows);
+		for (FWindowRecord& Record : OutView.Windows)
+		{
+			Reader << Record;
+		}
+
+		Reader << OutView.NamesSize;
+		if (Reader.IsError() || OutView.NamesSize < 0 || Reader.Tell() + OutView.NamesSize > Reader.TotalSize())
+		{
+			return false;
+		}
+		OutView.Names = reinterpret_cast<const char*>(Binary.GetData() + Reader.Tell());
+		Reader.Seek(Reader.Tell() + OutView.NamesSize);
+
+		Reader << OutView.ExtraSize;
+		if (Reader.IsError() || OutView.ExtraSize < 0 || Reader.Tell() + OutView.ExtraSize > Reader.TotalSize())
+		{
+			return false;
+		}
+		OutView.Extra = reinterpret_cast<const char*>(Binary.GetData() + Reader.Tell());
+
+		// Names must be zero-terminated within the names block.
+		for (const FWindowRecord& Record : OutView.Windows)
+		{
+			if (static_cast<int64>(Record.NameOffset) + Record.NameLength >= OutView.NamesSize
+				|| OutView.Names[Record.NameOffset + Record.NameLength] != '\0')
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	// Parse comma-separated pair of integers.
+	bool ParsePair(const char* Str, int16& OutX, int16& OutY)
+	{
+		char* End = nullptr;
+		const int32 X = FCStringAnsi::Strtoi(Str, &End, 10);
+		if (End == Str || *End != ',')
+		{
+			return false;
+		}
+
+		const char* Next = End + 1;
+		const int32 Y = FCStringAnsi::Strtoi(Next, &End, 10);
+		if (End == Next)
+		{
+			return false;
+		}
+
+		// Like in ImGui, values are truncated to 16 bits.
+		OutX = static_cast<int16>(X);
+		OutY = static_cast<int16>(Y);
+		return true;
+	}
+
+	void ReadWindowLine(const char* Line, FWindowRecord& Record)
+	{
+		if (FCStringAnsi::Strncmp(Line, "Pos=", 4) == 0)
+		{
+			ParsePair(Line + 4, Record.PosX, Record.PosY);
+		}
+		else if (FCStringAnsi::Strncmp(Line, "Size=", 5) == 0)
+		{
+			ParsePair(Line + 5, Record.SizeX, Record.SizeY);
+		}
+		else if (FCStringAnsi::Strncmp(Line, "Collapsed=", 10) == 0)
+		{
+			Record.bCollapsed = FCStringAnsi::Atoi(Line + 10) != 0;
+		}
+	}
+}
+
+namespace ImGuiSettingsFormat
+{
+	const TCHAR* GetFileExtension(EImGuiSettingsFormat Format)
+	{
+		return Format == EImGuiSettingsFormat::Binary ? TEXT(".imgui") : TEXT(".ini");
+	}
+
+	void IniToBinary(const char* Ini, SIZE_T Size, TArray<uint8>& OutBinary)
+	{
+		// Zero-terminated copy, in which we can terminate lines in place.
+		TArray<char> Buffer;
+		Buffer.Reserve(static_cast<int32>(Size) + 1);
+		Buffer.Append(Ini, static_cast<int32>(Size));
+		Buffer.Add('\0');
+
+		TArray<FWindowRecord> Windows;
+		TMap<uint32, int32> WindowIndices;
+		TArray<char> Names;
+		TArray<char> Extra;
+
+		// Section to which the following lines belong: a window record, extra settings or none.
+		FWindowRecord* Window = nullptr;
+		bool bIsExtraSection = false;
+
+		const int32 WindowSectionLength = FCStringAnsi::Strlen(WINDOW_SECTION);
+
+		char* const BufferEnd = Buffer.GetData() + Size;
+		for (char* Line = Buffer.GetData(); Line < BufferEnd; Line++)
+		{
+			// Like ImGui, skip empty lines and terminate line in place.
+			if (*Line == '\n' || *Line == '\r')
+			{
+				continue;
+			}
+
+			char* LineEnd = Line;
+			while (LineEnd < BufferEnd && *LineEnd != '\n' && *LineEnd != '\r')
+			{
+				LineEnd++;
+			}
+			*LineEnd = '\0';
+			const int32 LineLength = static_cast<int32>(LineEnd - Line);
+
+			if (Line[0] == '[' && LineEnd[-1] == ']')
+			{
+				// Parse "[Type][Name]" in the same way as ImGui does, so names can contain brackets.
+				const char* const NameEnd = LineEnd - 1;
+				const char* TypeEnd = ImStrchrRange(Line + 1, NameEnd, ']');
+				const char* NameStart = TypeEnd ? ImStrchrRange(TypeEnd + 1, NameEnd, '[') : nullptr;
+				const int32 TypeLength = TypeEnd ? static_cast<int32>(TypeEnd - Line - 1) : 0;
+
+				Window = nullptr;
+				bIsExtraSection = false;
+
+				if (NameStart && TypeLength == WindowSectionLength && FCStringAnsi::Strncmp(Line + 1, WINDOW_SECTION, TypeLength) == 0)
+				{
+					NameStart++;
+					const int32 NameLength = static_cast<int32>(NameEnd - NameStart);
+					const uint32 Id = ImHashStr(NameStart, NameLength);
+
+					if (const int32* Index = WindowIndices.Find(Id))
+					{
+						Window = &Windows[*Index];
+					}
+					else
+					{
+						WindowIndices.Add(Id, Windows.Num());
+						Window = &Windows.AddDefaulted_GetRef();
+						Window->Id = Id;
+						Window->NameLength = static_cast<uint16>(NameLength);
+						Window->NameOffset = static_cast<uint32>(Names.Num());
+						Names.Append(NameStart, NameLength);
+						Names.Add('\0');
+					}
+				}
+				else
+				{
+					// Separate sections with empty lines, like ImGui does.
+					if (Extra.Num() > 0)
+					{
+						Extra.Add('\n');
+					}
+					bIsExtraSection = true;
+				}
+			}
+			else if (Window)
+			{
+				ReadWindowLine(Line, *Window);
+			}
+
+			// Keep lines of other sections unchanged.
+			if (bIsExtraSection)
+			{
+				Extra.Append(Line, LineLength);
+				Extra.Add('\n');
+			}
+
+			Line = LineEnd;
+		}
+
+		if (Extra.Num() > 0)
+		{
+			Extra.Add('\n');
+		}
+
+		OutBinary.Reset(HEADER_SIZE + Windows.Num() * RECORD_SIZE + Names.Num() + Extra.Num() + 2 * sizeof(int32));
+		FMemoryWriter Writer{ OutBinary };
+
+		uint32 Magic = BINARY_MAGIC, Version = BINARY_VERSION;
+		int32 NumWindows = Windows.Num();
+		Writer << Magic << Version << NumWindows;
+		for (FWindowRecord& Record : Windows)
+		{
+			Writer << Record;
+		}
+
+		int32 NamesSize = Names.Num();
+		Writer << NamesSize;
+		Writer.Serialize(Names.GetData(), NamesSize);
+
+		int32 ExtraSize = Extra.Num();
+		Writer << ExtraSize;
+		Writer.Serialize(Extra.GetData(), ExtraSize);
+	}
+
+	bool BinaryToIni(const TArray<uint8>& Binary, TArray<uint8>& OutIni)
+	{
+		FBinaryView View;
+		if (!ReadBinary(Binary, View))
+		{
+			return false;
+		}
+
+		// Same layout as written by ImGui.
+		ImGuiTextBuffer Buffer;
+		for (const FWindowRecord& Record : View.Windows)
+		{
+			Buffer.appendf("[%s][%s]\n", WINDOW_SECTION, View.GetName(Record));
+			Buffer.appendf("Pos=%d,%d\n", Record.PosX, Record.PosY);
+			Buffer.appendf("Size=%d,%d\n", Record.SizeX, Record.SizeY);
+			Buffer.appendf("Collapsed=%d\n", Record.bCollapsed);
+			Buffer.append("\n");
+		}
+
+		OutIni.Reset(Buffer.size() + View.ExtraSize);
+		OutIni.Append(reinterpret_cast<const uint8*>(Buffer.begin()), Buffer.size());
+		OutIni.Append(reinterpret_cast<const uint8*>(View.Extra), View.ExtraSize);
+		return true;
+	}
+
+	void SplitIni(const char* Ini, SIZE_T Size, TArray<FIniSection>& OutSections)
+	{
+		FIniSection* Section = nullptr;
+
+		const char* const End = Ini + Size;
+		for (const char* Line = Ini; Line < End; )
+		{
+			const char* LineEnd = Line;
+			while (LineEnd < End && *LineEnd != '\n')
+			{
+				LineEnd++;
+			}
+
+			// Next line starts after the line break.
+			const char* const NextLine = (LineEnd < End) ? LineEnd + 1 : End;
+
+			const char* const HeaderEnd = (LineEnd > Line && LineEnd[-1] == '\r') ? LineEnd - 1 : LineEnd;
+			if (Line < HeaderEnd && Line[0] == '[' && HeaderEnd[-1] == ']')
+			{
+				const FUTF8ToTCHAR Header{ Line, static_cast<int32>(HeaderEnd - Line) };
+				Section = &OutSections.AddDefaulted_GetRef();
+				Section->Header = FString(Header.Length(), Header.Get());
+			}
+
+			if (Section)
+			{
+				Section->Text.Append(reinterpret_cast<const uint8*>(Line), static_cast<int32>(NextLine - Line));
+			}
+
+			Line = NextLine;
+		}
+
+		// Make sure that sections can be concatenated.
+		for (FIniSection& IniSection : OutSections)
+		{
+			if (IniSection.Text.Last() != '\n')
+			{
+				IniSection.Text.Add('\n');
+			}
+		}
+	}
+
+	bool LoadBinary(const TArray<uint8>& Binary)
+	{
+		FBinaryView View;
+		if (!ReadBinary(Binary, View))
+		{
+			return false;
+		}
+
+		// Add settings directly to the context storage. Ids are stored, so we don't need to hash names.
+		ImGuiContext& Context = *ImGui::GetCurrentContext();
+		for (const FWindowRecord& Record : View.Windows)
+		{
+			ImGuiWindowSettings* Settings = Context.SettingsWindows.alloc_chunk(sizeof(ImGuiWindowSettings) + Record.NameLength + 1);
+			IM_PLACEMENT_NEW(Settings) ImGuiWindowSettings();
+			Settings->ID = Record.Id;
+			Settings->Pos = ImVec2ih(Record.PosX, Record.PosY);
+			Settings->Size = ImVec2ih(Record.SizeX, Record.SizeY);
+			Settings->Collapsed = Record.bCollapsed != 0;
+			FMemory::Memcpy(Settings->GetName(), View.GetName(Record), Record.NameLength + 1);
+		}
+
+		if (View.ExtraSize > 0)
+		{
+			ImGui::LoadIniSettingsFromMemory(View.Extra, View.ExtraSize);
+		}
+
+		return true;
+	}
+
+	bool ConvertFile(const FString& File, FString& OutFile)
+	{
+		const FString Path = FPaths::IsRelative(File) ? FPaths::Combine(Utilities::GetSaveDirectory(), File) : File;
+		const bool bIsBinary = FPaths::GetExtension(Path, true) == GetFileExtension(EImGuiSettingsFormat::Binary);
+
+		TArray<uint8> Input;
+		if (!FFileHelper::LoadFileToArray(Input, *Path, FILEREAD_Silent))
+		{
+			UE_LOG(LogImGui, Warning, TEXT("Failed to load ImGui settings '%s'."), *Path);
+			return false;
+		}
+
+		TArray<uint8> Output;
+		if (bIsBinary)
+		{
+			if (!BinaryToIni(Input, Output))
+			{
+				UE_LOG(LogImGui, Warning, TEXT("File '%s' doesn't contain valid binary ImGui settings."), *Path);
+				return false;
+			}
+		}
+		else
+		{
+			IniToBinary(reinterpret_cast<const char*>(Input.GetData()), Input.Num(), Output);
+		}
+
+		OutFile = FPaths::ChangeExtension(Path, GetFileExtension(bIsBinary ? EImGuiSettingsFormat::Ini : EImGuiSettingsFormat::Binary));
+		if (!FFileHelper::SaveArrayToFile(Output, *OutFile))
+		{
+			UE_LOG(LogImGui, Warning, TEXT("Failed to save ImGui settings '%s'."), *OutFile);
+			return false;
+		}
+
+		return true;
+	}
+}
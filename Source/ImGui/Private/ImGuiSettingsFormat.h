@@ -0,0 +1,54 @@
+// Distributed under the MIT License (MIT) (see accompanying LICENSE file)
+
+#pragma once
+
+#include "ImGuiModuleSettings.h"
+
+
+// Conversions between formats of ImGui settings.
+//
+// Binary format is designed for fast loading. It stores window settings in fixed-size records with pre-computed window
+// ids, followed by a block of window names, so they can be added to a context without parsing or hashing. Settings
+// of other handlers (if there are any) are kept as an ini text that follows names.
+namespace ImGuiSettingsFormat
+{
+	// Section of settings in ini format: a "[Type][Name]" header with the following lines.
+	struct FIniSection
+	{
+		FString Header;
+		TArray<uint8> Text;
+	};
+
+	// Get the extension of files with settings in given format.
+	const TCHAR* GetFileExtension(EImGuiSettingsFormat Format);
+
+	// Convert settings in ini format to binary format.
+	// @param Ini - Settings in ini format
+	// @param Size - Size of the ini data in bytes
+	// @param OutBinary - Array that receives settings in binary format
+	void IniToBinary(const char* Ini, SIZE_T Size, TArray<uint8>& OutBinary);
+
+	// Convert settings in binary format to ini format.
+	// @param Binary - Settings in binary format
+	// @param OutIni - Array that receives settings in ini format
+	// @returns True, if conversion was successful and false, if binary data are not valid
+	bool BinaryToIni(const TArray<uint8>& Binary, TArray<uint8>& OutIni);
+
+	// Split settings in ini format into sections. Lines before the first section are skipped.
+	// @param Ini - Settings in ini format
+	// @param Size - Size of the ini data in bytes
+	// @param OutSections - Array that receives sections, each with complete text including header and empty lines
+	void SplitIni(const char* Ini, SIZE_T Size, TArray<FIniSection>& OutSections);
+
+	// Load settings in binary format to the current ImGui context. Like loading ini settings, it must be done before
+	// the first frame.
+	// @param Binary - Settings in binary format
+	// @returns True, if settings were loaded and false, if binary data are not valid
+	bool LoadBinary(const TArray<uint8>& Binary);
+
+	// Convert a settings file to the other format, based on its extension. Output is saved next to the source file.
+	// @param File - Path to a settings file (relative paths are resolved against the module save directory)
+	// @param OutFile - Path to the output file
+	// @returns True, if file was converted
+	bool ConvertFile(const FString& File, FString& OutFile);
+}
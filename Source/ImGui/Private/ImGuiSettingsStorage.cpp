@@ -0,0 +1,354 @@
+// Distributed under the MIT License (MIT) (see accompanying LICENSE file)
+
+#include "ImGuiPrivatePCH.h"
+
+#include "ImGuiSettingsStorage.h"
+
+#include "ImGuiSettingsFormat.h"
+#include "Utilities/Paths.h"
+
+#include <HAL/FileManager.h>
+#include <Misc/FileHelper.h>
+
+#include <imgui.h>
+
+
+// Time in seconds for which settings need to stay unchanged, before they are written.
+static constexpr double SAVE_DEBOUNCE_DELAY = 1.0;
+
+namespace
+{
+	// Name of the file with shared settings (without extension).
+	const TCHAR* const SETTINGS_FILE_NAME = TEXT("Settings");
+
+	FString GetSettingsFile(const FString& Directory, const FString& Name, EImGuiSettingsFormat Format)
+	{
+		return FPaths::Combine(Directory, Name + ImGuiSettingsFormat::GetFileExtension(Format));
+	}
+
+	EImGuiSettingsFormat GetFileFormat(const FString& File)
+	{
+		return FPaths::GetExtension(File, true) == ImGuiSettingsFormat::GetFileExtension(EImGuiSettingsFormat::Binary)
+			? EImGuiSettingsFormat::Binary : EImGuiSettingsFormat::Ini;
+	}
+
+	// Read settings file in any format and split it into ini sections. Content of binary file can be also returned, so
+	// it can be loaded without parsing.
+	bool ReadSettingsFile(const FString& File, TArray<ImGuiSettingsFormat::FIniSection>& OutSections, TArray<uint8>* OutBinary = nullptr)
+	{
+		TArray<uint8> Data;
+		if (!FFileHelper::LoadFileToArray(Data, *File, FILEREAD_Silent))
+		{
+			return false;
+		}
+
+		if (GetFileFormat(File) == EImGuiSettingsFormat::Binary)
+		{
+			TArray<uint8> Ini;
+			if (!ImGuiSettingsFormat::BinaryToIni(Data, Ini))
+			{
+				UE_LOG(LogImGui, Warning, TEXT("File '%s' doesn't contain valid binary ImGui settings."), *File);
+				return false;
+			}
+
+			if (OutBinary)
+			{
+				*OutBinary = MoveTemp(Data);
+			}
+			Data = MoveTemp(Ini);
+		}
+
+		ImGuiSettingsFormat::SplitIni(reinterpret_cast<const char*>(Data.GetData()), Data.Num(), OutSections);
+		return true;
+	}
+
+	void WriteSettingsFile(const FString& File, const TArray<uint8>& Data)
+	{
+		// Write to a temporary file and replace the old file only after successful write.
+		const FString TempFile = File + TEXT(".tmp");
+
+		if (!FFileHelper::SaveArrayToFile(Data, *TempFile) || !IFileManager::Get().Move(*File, *TempFile))
+		{
+			UE_LOG(LogImGui, Warning, TEXT("Failed to save ImGui settings '%s'."), *File);
+			IFileManager::Get().Delete(*TempFile, false, false, true);
+		}
+	}
+}
+
+FImGuiSettingsStorage::FImGuiSettingsStorage(const FImGuiModuleSettings& InSettings)
+	: Settings(InSettings)
+	, Directory(Utilities::GetSaveDirectory())
+	, ReadData(MakeShared<FReadData, ESPMode::ThreadSafe>())
+{
+	ReadTask = FFunctionGraphTask::CreateAndDispatchWhenReady(
+		[Data = ReadData, Directory = Directory]()
+		{
+			ReadFiles(Directory, *Data);
+		}, TStatId(), nullptr, ENamedThreads::AnyThread);
+}
+
+FImGuiSettingsStorage::~FImGuiSettingsStorage()
+{
+	// Make sure that settings are saved and that tasks are not running code from this module when it is unloaded.
+	Flush();
+}
+
+void FImGuiSettingsStorage::LoadSettings(const FString& ContextName)
+{
+	CompleteRead();
+
+	// Context starts with the shared sections. Sections are immutable, so they are shared without copying.
+	ContextSections.Add(ContextName, Sections);
+
+	if (Sections.Num() == 0)
+	{
+		return;
+	}
+
+	// Binary data is only available after it was read from or written to the file, so it is never converted on the game
+	// thread. Without it, sections are joined to ini, which is faster to load than converting it to binary first.
+	if (Serialized.Data.Num() == 0 || (Serialized.Format == EImGuiSettingsFormat::Binary && !ImGuiSettingsFormat::LoadBinary(Serialized.Data)))
+	{
+		TArray<FSectionRef> SectionArray;
+		Sections.GenerateValueArray(SectionArray);
+		Serialize(SectionArray, EImGuiSettingsFormat::Ini, Serialized.Data);
+		Serialized.Format = EImGuiSettingsFormat::Ini;
+	}
+
+	// Reuse for all contexts loaded before the next change.
+	if (Serialized.Format == EImGuiSettingsFormat::Ini)
+	{
+		ImGui::LoadIniSettingsFromMemory(reinterpret_cast<const char*>(Serialized.Data.GetData()), Serialized.Data.Num());
+	}
+}
+
+void FImGuiSettingsStorage::SaveSettings(const FString& ContextName)
+{
+	CompleteRead();
+
+	size_t Size = 0;
+	const char* Ini = ImGui::SaveIniSettingsToMemory(&Size);
+
+	TArray<ImGuiSettingsFormat::FIniSection> IniSections;
+	ImGuiSettingsFormat::SplitIni(Ini, Size, IniSections);
+
+	FSections& BaseSections = ContextSections.FindOrAdd(ContextName);
+
+	bool bChanged = false;
+	for (ImGuiSettingsFormat::FIniSection& IniSection : IniSections)
+	{
+		// Publish only sections changed by this context.
+		const FSectionRef* BaseSection = BaseSections.Find(IniSection.Header);
+		if (!BaseSection || **BaseSection != IniSection.Text)
+		{
+			const FSectionRef Section = MakeShared<const TArray<uint8>, ESPMode::ThreadSafe>(MoveTemp(IniSection.Text));
+			BaseSections.Add(IniSection.Header, Section);
+
+			const FSectionRef* SharedSection = Sections.Find(IniSection.Header);
+			if (!SharedSection || **SharedSection != *Section)
+			{
+				Sections.Add(IniSection.Header, Section);
+				bChanged = true;
+			}
+		}
+	}
+
+	if (bChanged)
+	{
+		Serialized.Data.Reset();
+		bIsDirty = true;
+		ChangeTime = FPlatformTime::Seconds();
+	}
+}
+
+void FImGuiSettingsStorage::Update()
+{
+	if (WriteTask.IsValid() && WriteTask->IsComplete())
+	{
+		WriteTask = nullptr;
+
+		// Keep written binary data for loading, if settings didn't change since the write started.
+		if (!bIsDirty && WrittenData.IsValid() && WrittenData->Format == EImGuiSettingsFormat::Binary)
+		{
+			Serialized = MoveTemp(*WrittenData);
+		}
+		WrittenData.Reset();
+	}
+
+	if (bIsDirty && !WriteTask.IsValid() && FPlatformTime::Seconds() - ChangeTime >= SAVE_DEBOUNCE_DELAY)
+	{
+		Write();
+	}
+}
+
+void FImGuiSettingsStorage::RequestWrite()
+{
+	// Make sure that the file is not overwritten before its content is read.
+	CompleteRead();
+
+	if (Sections.Num() > 0)
+	{
+		bIsDirty = true;
+		ChangeTime = FPlatformTime::Seconds();
+	}
+}
+
+void FImGuiSettingsStorage::Flush()
+{
+	CompleteRead();
+
+	if (bIsDirty)
+	{
+		// Wait for the previous write to keep the order of writes.
+		if (WriteTask.IsValid())
+		{
+			FTaskGraphInterface::Get().WaitUntilTaskCompletes(WriteTask);
+		}
+		Write();
+	}
+
+	if (WriteTask.IsValid())
+	{
+		FTaskGraphInterface::Get().WaitUntilTaskCompletes(WriteTask);
+		WriteTask = nullptr;
+	}
+}
+
+void FImGuiSettingsStorage::CompleteRead()
+{
+	if (ReadTask.IsValid())
+	{
+		FTaskGraphInterface::Get().WaitUntilTaskCompletes(ReadTask);
+		ReadTask = nullptr;
+
+		Sections = MoveTemp(ReadData->Sections);
+		Serialized = MoveTemp(ReadData->Serialized);
+		bHasValidSource = ReadData->bHasValidSource;
+		ReadData.Reset();
+	}
+}
+
+void FImGuiSettingsStorage::ReadFiles(const FString& Directory, FReadData& OutData)
+{
+	auto AddSections = [&OutSections = OutData.Sections](const FString& File, TArray<uint8>* OutBinary = nullptr)
+	{
+		TArray<ImGuiSettingsFormat::FIniSection> IniSections;
+		if (!ReadSettingsFile(File, IniSections, OutBinary))
+		{
+			return false;
+		}
+
+		for (ImGuiSettingsFormat::FIniSection& IniSection : IniSections)
+		{
+			// Keep the first occurrence.
+			if (!OutSections.Contains(IniSection.Header))
+			{
+				OutSections.Add(IniSection.Header, MakeShared<const TArray<uint8>, ESPMode::ThreadSafe>(MoveTemp(IniSection.Text)));
+			}
+		}
+		return true;
+	};
+
+	// If there are shared settings in both formats, use the more recent one.
+	const FString IniFile = GetSettingsFile(Directory, SETTINGS_FILE_NAME, EImGuiSettingsFormat::Ini);
+	const FString BinaryFile = GetSettingsFile(Directory, SETTINGS_FILE_NAME, EImGuiSettingsFormat::Binary);
+	const FDateTime IniTimeStamp = IFileManager::Get().GetTimeStamp(*IniFile);
+	const FDateTime BinaryTimeStamp = IFileManager::Get().GetTimeStamp(*BinaryFile);
+
+	if (IniTimeStamp != FDateTime::MinValue() || BinaryTimeStamp != FDateTime::MinValue())
+	{
+		// If the more recent file cannot be read, fall back to the other one, so layouts are not lost because of a single
+		// broken file.
+		if (BinaryTimeStamp > IniTimeStamp)
+		{
+			// Binary file contains exactly the read sections, so it can be loaded to contexts directly.
+			OutData.bHasValidSource = AddSections(BinaryFile, &OutData.Serialized.Data);
+			if (OutData.bHasValidSource)
+			{
+				OutData.Serialized.Format = EImGuiSettingsFormat::Binary;
+			}
+			else if (IniTimeStamp != FDateTime::MinValue())
+			{
+				OutData.bHasValidSource = AddSections(IniFile);
+			}
+		}
+		else
+		{
+			OutData.bHasValidSource = AddSections(IniFile);
+			if (!OutData.bHasValidSource && BinaryTimeStamp != FDateTime::MinValue())
+			{
+				OutData.bHasValidSource = AddSections(BinaryFile, &OutData.Serialized.Data);
+				if (OutData.bHasValidSource)
+				{
+					OutData.Serialized.Format = EImGuiSettingsFormat::Binary;
+				}
+			}
+		}
+		return;
+	}
+
+	// Without shared settings, there is no other format file that could be lost when writing.
+	OutData.bHasValidSource = true;
+
+	// Without shared settings, merge files of individual contexts saved by older versions, so layouts are not lost.
+	for (EImGuiSettingsFormat Format : { EImGuiSettingsFormat::Ini, EImGuiSettingsFormat::Binary })
+	{
+		// Extension without the leading dot.
+		TArray<FString> Files;
+		IFileManager::Get().FindFiles(Files, *Directory, ImGuiSettingsFormat::GetFileExtension(Format) + 1);
+
+		for (const FString& File : Files)
+		{
+			AddSections(FPaths::Combine(Directory, File));
+		}
+	}
+}
+
+void FImGuiSettingsStorage::Serialize(const TArray<FSectionRef>& Sections, EImGuiSettingsFormat Format, TArray<uint8>& OutData)
+{
+	TArray<uint8> Ini;
+	for (const FSectionRef& Section : Sections)
+	{
+		Ini.Append(*Section);
+	}
+
+	if (Format == EImGuiSettingsFormat::Binary)
+	{
+		ImGuiSettingsFormat::IniToBinary(reinterpret_cast<const char*>(Ini.GetData()), Ini.Num(), OutData);
+	}
+	else
+	{
+		OutData = MoveTemp(Ini);
+	}
+}
+
+void FImGuiSettingsStorage::Write()
+{
+	const EImGuiSettingsFormat Format = Settings.GetSettingsFormat();
+	const EImGuiSettingsFormat OtherFormat = (Format == EImGuiSettingsFormat::Binary) ? EImGuiSettingsFormat::Ini : EImGuiSettingsFormat::Binary;
+
+	// Sections are immutable, so the task can serialize them in background.
+	TArray<FSectionRef> SectionArray;
+	Sections.GenerateValueArray(SectionArray);
+
+	bIsDirty = false;
+	WrittenData = MakeShared<FSerializedSettings, ESPMode::ThreadSafe>();
+
+	// Keep file in the other format, unless its content is in the written sections.
+	const bool bDeleteOtherFile = bHasValidSource;
+
+	WrittenData->Format = Format;
+	WriteTask = FFunctionGraphTask::CreateAndDispatchWhenReady(
+		[File = GetSettingsFile(Directory, SETTINGS_FILE_NAME, Format), OtherFile = GetSettingsFile(Directory, SETTINGS_FILE_NAME, OtherFormat),
+		SectionArray = MoveTemp(SectionArray), Data = WrittenData, bDeleteOtherFile]()
+		{
+			Serialize(SectionArray, Data->Format, Data->Data);
+			WriteSettingsFile(File, Data->Data);
+
+			// Remove file in the other format, so it is not loaded instead of this one.
+			if (bDeleteOtherFile)
+			{
+				IFileManager::Get().Delete(*OtherFile, false, false, true);
+			}
+		}, TStatId(), nullptr, ENamedThreads::AnyThread);
+}
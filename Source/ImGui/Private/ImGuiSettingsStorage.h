@@ -0,0 +1,114 @@
+// Distributed under the MIT License (MIT) (see accompanying LICENSE file)
+
+#pragma once
+
+#include "ImGuiModuleSettings.h"
+
+#include <Async/TaskGraphInterfaces.h>
+#include <Containers/Map.h>
+#include <Templates/SharedPointer.h>
+
+
+// Storage of ImGui settings shared by all contexts and persisted in a single file in the module save directory.
+// Contexts don't use ImGui file functions but exchange settings with this storage in memory, and the file is read and
+// written by background tasks, so file I/O doesn't cause hitches on the game thread.
+//
+// Settings are stored in sections (like "[Window][Name]"), which are shared between storage and contexts. Contexts load
+// the shared settings when they are created and they keep their own copy, which they modify as windows change. When
+// context saves its settings, only sections that it changed since its last load or save are published to the storage,
+// so contexts don't overwrite changes made by other contexts with their older copies.
+//
+// The file is read by a task started when storage is created, so its data is usually ready before contexts need it.
+// Writes are debounced, so a burst of changes (like dragging a window) results in a single write, and the file is
+// replaced atomically by renaming a temporary file. It is saved in the format defined in module settings and loaded from
+// the most recent file in any format.
+class FImGuiSettingsStorage
+{
+public:
+
+	FImGuiSettingsStorage(const FImGuiModuleSettings& InSettings);
+	~FImGuiSettingsStorage();
+
+	FImGuiSettingsStorage(const FImGuiSettingsStorage&) = delete;
+	FImGuiSettingsStorage& operator=(const FImGuiSettingsStorage&) = delete;
+
+	FImGuiSettingsStorage(FImGuiSettingsStorage&&) = delete;
+	FImGuiSettingsStorage& operator=(FImGuiSettingsStorage&&) = delete;
+
+	// Load shared settings to the current ImGui context. ImGui allows that only before the first frame. If the file is
+	// still being read, it waits until it is ready.
+	// @param ContextName - Name of the context, used to track which settings it changes
+	void LoadSettings(const FString& ContextName);
+
+	// Publish settings that the current ImGui context changed since it loaded or saved them and schedule writing them
+	// to the file.
+	// @param ContextName - Name of the context, used to track which settings it changes
+	void SaveSettings(const FString& ContextName);
+
+	// Start writing settings, if they didn't change for longer than the debounce delay. Should be called once per frame.
+	void Update();
+
+	// Schedule writing settings even if they didn't change, e.g. to convert the file after format change.
+	void RequestWrite();
+
+	// Write modified settings and wait until all writes are complete.
+	void Flush();
+
+private:
+
+	using FSectionRef = TSharedRef<const TArray<uint8>, ESPMode::ThreadSafe>;
+
+	// Sections with their headers as keys, in order of adding.
+	using FSections = TMap<FString, FSectionRef>;
+
+	// Settings serialized in a format in which they can be loaded to contexts.
+	struct FSerializedSettings
+	{
+		TArray<uint8> Data;
+		EImGuiSettingsFormat Format = EImGuiSettingsFormat::Ini;
+	};
+
+	struct FReadData
+	{
+		FSections Sections;
+		FSerializedSettings Serialized;
+		bool bHasValidSource = false;
+	};
+
+	static void ReadFiles(const FString& Directory, FReadData& OutData);
+
+	static void Serialize(const TArray<FSectionRef>& Sections, EImGuiSettingsFormat Format, TArray<uint8>& OutData);
+
+	void CompleteRead();
+
+	void Write();
+
+	const FImGuiModuleSettings& Settings;
+
+	FString Directory;
+
+	// Settings shared by all contexts.
+	FSections Sections;
+
+	// Sections as they were last loaded or saved by each context.
+	TMap<FString, FSections> ContextSections;
+
+	// Shared settings serialized for loading, released after they change. Binary data read from or written to the file
+	// is kept, so contexts can load it without parsing.
+	FSerializedSettings Serialized;
+
+	// Whether shared settings were read from a valid file, or there was no file to read. If not, writes don't delete
+	// the file in the other format, which might be the only copy of saved layouts.
+	bool bHasValidSource = false;
+
+	// Time of the last change that wasn't written yet.
+	double ChangeTime = 0.0;
+	bool bIsDirty = false;
+
+	// At most one write is in progress, so a newer data can't be overwritten by an older one.
+	FGraphEventRef WriteTask;
+	TSharedPtr<FSerializedSettings, ESPMode::ThreadSafe> WrittenData;
+
+	TSharedPtr<FReadData, ESPMode::ThreadSafe> ReadData;
+	FGraphEventRef ReadTask;
+};
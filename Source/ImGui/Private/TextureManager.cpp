@@ -4,9 +4,21 @@
 
 #include "TextureManager.h"
 
+#include <Materials/MaterialInstanceDynamic.h>
+
 #include <algorithm>
 
 
+namespace
+{
+	EPixelFormat GetPixelFormat(uint32 Bpp)
+	{
+		checkf(Bpp == 1 || Bpp == 4, TEXT("Unsupported texture bytes per pixel %u. Supported are 1 (single-channel) and 4 (BGRA)."), Bpp);
+		return (Bpp == 1) ? PF_G8 : PF_B8G8R8A8;
+	}
+}
+
+
 void FTextureManager::InitializeErrorTexture(const FColor& Color)
 {
 	CreatePlainTextureInternal(NAME_ErrorTexture, 2, 2, Color);
@@ -20,6 +32,32 @@ TextureIndex FTextureManager::CreateTexture(const FName& Name, int32 Width, int3
 	return CreateTextureInternal(Name, Width, Height, SrcBpp, SrcData, SrcDataCleanup);
 }
 
+void FTextureManager::UpdateTextureRegion(TextureIndex Index, const FIntRect& Region, uint32 SrcBpp, uint32 SrcPitch, const uint8* SrcData)
+{
+	checkf(IsValidTexture(Index), TEXT("Invalid texture index %d."), Index);
+
+	UTexture2D* Texture = TextureResources[Index].Texture.Get();
+	checkf(Texture, TEXT("Only textures created by texture manager can be updated ('%s' is external)."),
+		*TextureResources[Index].Name.ToString());
+
+	// Copy the region, so the source can be modified while the update is pending on the render thread.
+	const uint32 RowSize = Region.Width() * SrcBpp;
+	uint8* RegionData = new uint8[RowSize * Region.Height()];
+	for (int32 Row = 0; Row < Region.Height(); Row++)
+	{
+		FMemory::Memcpy(RegionData + Row * RowSize, SrcData + (Region.Min.Y + Row) * SrcPitch + Region.Min.X * SrcBpp, RowSize);
+	}
+
+	FUpdateTextureRegion2D* TextureRegion = new FUpdateTextureRegion2D(Region.Min.X, Region.Min.Y, 0, 0,
+		Region.Width(), Region.Height());
+	auto DataCleanup = [](uint8* Data, const FUpdateTextureRegion2D* UpdateRegion)
+	{
+		delete[] Data;
+		delete UpdateRegion;
+	};
+	Texture->UpdateTextureRegions(0, 1u, TextureRegion, RowSize, SrcBpp, RegionData, DataCleanup);
+}
+
 TextureIndex FTextureManager::CreatePlainTexture(const FName& Name, int32 Width, int32 Height, FColor Color)
 {
 	checkf(Name != NAME_None, TEXT("Trying to create a texture with a name 'NAME_None' is not allowed."));
@@ -43,6 +81,20 @@ TextureIndex FTextureManager::CreateTextureResources(const FName& Name, UTexture
 	return AddTextureEntry(Name, Texture, false, true);
 }
 
+void FTextureManager::SetTextureMaterial(TextureIndex Index, UMaterialInterface* Material, const FName& TextureParameterName)
+{
+	checkf(IsValidTexture(Index), TEXT("Invalid texture index %d."), Index);
+	checkf(Material, TEXT("Null Material."));
+
+	FTextureEntry& Entry = TextureResources[Index];
+	checkf(Entry.Texture.IsValid(), TEXT("Materials are only supported for textures created by texture manager ('%s' is external)."),
+		*Entry.Name.ToString());
+
+	UMaterialInstanceDynamic* MaterialInstance = UMaterialInstanceDynamic::Create(Material, nullptr);
+	MaterialInstance->SetTextureParameterValue(TextureParameterName, Entry.Texture.Get());
+	Entry.SetMaterial(MaterialInstance);
+}
+
 void FTextureManager::ReleaseTextureResources(TextureIndex Index)
 {
 	checkf(IsInRange(Index), TEXT("Invalid texture index %d. Texture resources array has %d entries total."), Index, TextureResources.Num());
@@ -53,7 +105,13 @@ void FTextureManager::ReleaseTextureResources(TextureIndex Index)
 TextureIndex FTextureManager::CreateTextureInternal(const FName& Name, int32 Width, int32 Height, uint32 SrcBpp, uint8* SrcData, TFunction<void(uint8*)> SrcDataCleanup)
 {
 	// Create a texture.
-	UTexture2D* Texture = UTexture2D::CreateTransient(Width, Height);
+	UTexture2D* Texture = UTexture2D::CreateTransient(Width, Height, GetPixelFormat(SrcBpp));
+
+	// Single-channel textures store linear data, like coverage or distance, so they shouldn't be gamma corrected.
+	if (SrcBpp == 1)
+	{
+		Texture->SRGB = false;
+	}
 
 	// Create a new resource for that texture.
 	Texture->UpdateResource();
@@ -148,6 +206,7 @@ FTextureManager::FTextureEntry& FTextureManager::FTextureEntry::operator=(FTextu
 	// Move data and ownership to this instance.
 	Name = MoveTemp(Other.Name);
 	Texture = MoveTemp(Other.Texture);
+	Material = MoveTemp(Other.Material);
 	Brush = MoveTemp(Other.Brush);
 	ResourceHandle = MoveTemp(Other.ResourceHandle);
 
@@ -158,22 +217,52 @@ FTextureManager::FTextureEntry& FTextureManager::FTextureEntry::operator=(FTextu
 	return *this;
 }
 
+void FTextureManager::FTextureEntry::SetMaterial(UMaterialInstanceDynamic* InMaterial)
+{
+	checkf(InMaterial, TEXT("Null material."));
+
+	// Release resources that are replaced by the new material.
+	ReleaseBrush();
+	if (Material.IsValid())
+	{
+		Material->RemoveFromRoot();
+	}
+
+	// Material instance is owned by this entry, so we need to protect it from garbage collection.
+	Material = InMaterial;
+	InMaterial->AddToRoot();
+
+	// Create brush and resource handle for input material.
+	Brush.SetResourceObject(InMaterial);
+	ResourceHandle = FSlateApplication::Get().GetRenderer()->GetResourceHandle(Brush);
+}
+
+void FTextureManager::FTextureEntry::ReleaseBrush()
+{
+	if (Brush.HasUObject() && FSlateApplication::IsInitialized())
+	{
+		FSlateApplication::Get().GetRenderer()->ReleaseDynamicResource(Brush);
+	}
+}
+
 void FTextureManager::FTextureEntry::Reset(bool bReleaseResources)
 {
 	if (bReleaseResources)
 	{
 		// Release brush.
-		if (Brush.HasUObject() && FSlateApplication::IsInitialized())
-		{
-			FSlateApplication::Get().GetRenderer()->ReleaseDynamicResource(Brush);
-		}
+		ReleaseBrush();
 
-		// Remove texture from root to allow for garbage collection (it might be invalid, if we never set it
-		// or this is an application shutdown).
+		// Remove texture and material from root to allow for garbage collection (they might be invalid, if we never
+		// set them or this is an application shutdown).
 		if (Texture.IsValid())
 		{
 			Texture->RemoveFromRoot();
 		}
+
+		if (Material.IsValid())
+		{
+			Material->RemoveFromRoot();
+		}
 	}
 
 	// We use empty name to mark unused entries.
@@ -181,6 +270,7 @@ void FTextureManager::FTextureEntry::Reset(bool bReleaseResources)
 
 	// Clean fields to make sure that we don't reference released or moved resources.
 	Texture.Reset();
+	Material.Reset();
 	Brush = FSlateNoResource();
 	ResourceHandle = FSlateResourceHandle();
 }
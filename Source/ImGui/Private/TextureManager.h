@@ -64,12 +64,21 @@ public:
 	// @param Name - The texture name
 	// @param Width - The texture width
 	// @param Height - The texture height
-	// @param SrcBpp - The size in bytes of one pixel
+	// @param SrcBpp - The size in bytes of one pixel (1 for single-channel and 4 for BGRA textures)
 	// @param SrcData - The source data
 	// @param SrcDataCleanup - Optional function called to release source data after texture is created (only needed, if data need to be released)
 	// @returns The index of a texture that was created
 	TextureIndex CreateTexture(const FName& Name, int32 Width, int32 Height, uint32 SrcBpp, uint8* SrcData, TFunction<void(uint8*)> SrcDataCleanup = [](uint8*) {});
 
+	// Update a region of a texture created by this manager. Region is copied from source data, so they can be modified
+	// or released right after this call.
+	// @param Index - The index of a texture created by this manager
+	// @param Region - The region to update (source data use the same coordinates)
+	// @param SrcBpp - The size in bytes of one pixel (needs to match the texture format)
+	// @param SrcPitch - The size in bytes of one row of source data
+	// @param SrcData - The source data
+	void UpdateTextureRegion(TextureIndex Index, const FIntRect& Region, uint32 SrcBpp, uint32 SrcPitch, const uint8* SrcData);
+
 	// Create a plain texture. Throws exception if there is already a texture with that name.
 	// @param Name - The texture name
 	// @param Width - The texture width
@@ -89,6 +98,14 @@ public:
 	// @returns The index to created/updated texture resources
 	TextureIndex CreateTextureResources(const FName& Name, UTexture2D* Texture, bool bMakeUnique = true);
 
+	// Render texture created by this manager using a material. Dynamic instance of the material is created with the
+	// texture assigned to the given parameter and it replaces texture as a Slate resource. This allows to use textures
+	// that need additional processing in shader, like single-channel textures that need to be swizzled.
+	// @param Index - The index of a texture created by this manager
+	// @param Material - The parent material
+	// @param TextureParameterName - The name of the texture parameter in material
+	void SetTextureMaterial(TextureIndex Index, UMaterialInterface* Material, const FName& TextureParameterName);
+
 	// Release resources for given texture. Ignores invalid indices.
 	// @param Index - The index of a texture resources
 	void ReleaseTextureResources(TextureIndex Index);
@@ -140,13 +157,18 @@ private:
 		// ... but we need move assignment to support reusing entries.
 		FTextureEntry& operator=(FTextureEntry&& Other);
 
+		// Use material instance as a Slate resource for this entry.
+		void SetMaterial(UMaterialInstanceDynamic* InMaterial);
+
 		FName Name = NAME_None;
 		TWeakObjectPtr<UTexture2D> Texture;
+		TWeakObjectPtr<UMaterialInstanceDynamic> Material;
 		FSlateBrush Brush;
 		FSlateResourceHandle ResourceHandle;
 
 	private:
 
+		void ReleaseBrush();
 		void Reset(bool bReleaseResources);
 	};
 
@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include "IndexSet.h"
 #include "Range.h"
 
 #include <array>
@@ -60,4 +61,13 @@ namespace Utilities
 	// Array indices range. Limited by 0 and array size.
 	template<typename TArray, typename SizeType>
 	using TArrayIndexRange = TBoundedRange<SizeType, 0, ArraySize<TArray>::value>;
+
+
+	//====================================================================================================
+	// Index Sets
+	//====================================================================================================
+
+	// Set of array indices. Limited by array size.
+	template<typename TArray>
+	using TArrayIndexSet = TIndexSet<ArraySize<TArray>::value>;
 }
@@ -0,0 +1,102 @@
+// Distributed under the MIT License (MIT) (see accompanying LICENSE file)
+
+#pragma once
+
+#include <cstddef>
+
+
+namespace Utilities
+{
+	//====================================================================================================
+	// Index Set
+	//====================================================================================================
+
+	// Set of indices in range from 0 to N, stored as bits. Iteration visits only indices in the set, skipping whole
+	// words without any index, so it is cheap for sparse sets regardless of the distance between indices.
+	template<std::size_t N>
+	class TIndexSet
+	{
+	public:
+
+		static constexpr uint32 Size = static_cast<uint32>(N);
+
+		bool IsEmpty() const
+		{
+			for (uint32 Word : Words)
+			{
+				if (Word)
+				{
+					return false;
+				}
+			}
+			return true;
+		}
+
+		bool Contains(uint32 Index) const
+		{
+			checkf(Index < Size, TEXT("Index out of range."));
+			return (Words[Index / BitsPerWord] & (1u << (Index % BitsPerWord))) != 0;
+		}
+
+		void Add(uint32 Index)
+		{
+			checkf(Index < Size, TEXT("Index out of range."));
+			Words[Index / BitsPerWord] |= (1u << (Index % BitsPerWord));
+		}
+
+		void Remove(uint32 Index)
+		{
+			checkf(Index < Size, TEXT("Index out of range."));
+			Words[Index / BitsPerWord] &= ~(1u << (Index % BitsPerWord));
+		}
+
+		void SetEmpty()
+		{
+			for (uint32& Word : Words)
+			{
+				Word = 0;
+			}
+		}
+
+		void SetFull()
+		{
+			for (uint32& Word : Words)
+			{
+				Word = ~0u;
+			}
+
+			// Clear bits beyond the range, so iteration never visits them.
+			if (Size % BitsPerWord)
+			{
+				Words[NumWords - 1] = (1u << (Size % BitsPerWord)) - 1;
+			}
+		}
+
+		// Call function for each index in the set, in ascending order.
+		// @param Func - Function taking index as an argument
+		template<typename TFunc>
+		void ForEach(TFunc&& Func) const
+		{
+			for (uint32 WordIndex = 0; WordIndex < NumWords; WordIndex++)
+			{
+				uint32 Word = Words[WordIndex];
+				while (Word)
+				{
+					Func(WordIndex * BitsPerWord + FMath::CountTrailingZeros(Word));
+
+					// Clear the lowest set bit.
+					Word &= Word - 1;
+				}
+			}
+		}
+
+	private:
+
+		// 32-bit words, because count of trailing zeros for 64-bit values is not available in all supported engine
+		// versions.
+		static constexpr uint32 BitsPerWord = 32;
+		static constexpr uint32 NumWords = (Size + BitsPerWord - 1) / BitsPerWord;
+
+		uint32 Words[NumWords] = {};
+	};
+}
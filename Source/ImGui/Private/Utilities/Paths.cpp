@@ -0,0 +1,34 @@
+// Distributed under the MIT License (MIT) (see accompanying LICENSE file)
+
+#include "ImGuiPrivatePCH.h"
+
+#include "Paths.h"
+
+
+namespace Utilities
+{
+	namespace
+	{
+		FString CreateSaveDirectory()
+		{
+#if ENGINE_COMPATIBILITY_LEGACY_SAVED_DIR
+			const FString SavedDir = FPaths::GameSavedDir();
+#else
+			const FString SavedDir = FPaths::ProjectSavedDir();
+#endif
+
+			FString Directory = FPaths::Combine(*SavedDir, TEXT("ImGui"));
+
+			// Make sure that directory is created.
+			IPlatformFile::GetPlatformPhysical().CreateDirectory(*Directory);
+
+			return Directory;
+		}
+	}
+
+	const FString& GetSaveDirectory()
+	{
+		static FString SaveDirectory = CreateSaveDirectory();
+		return SaveDirectory;
+	}
+}
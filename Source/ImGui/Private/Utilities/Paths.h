@@ -0,0 +1,14 @@
+// Distributed under the MIT License (MIT) (see accompanying LICENSE file)
+
+#pragma once
+
+#include <Core.h>
+
+
+// Utilities helping to get module paths.
+
+namespace Utilities
+{
+	// Get the directory where ImGui module stores its data (created during the first call).
+	const FString& GetSaveDirectory();
+}
@@ -13,7 +13,8 @@
 // rectangle and unofficial GSlateScissorRect to correctly clip custom vertices made with FSlateDrawElement.
 #define ENGINE_COMPATIBILITY_LEGACY_CLIPPING_API        BELOW_ENGINE_VERSION(4, 17)
 
-// Starting from version 4.18, FPaths::GameSavedDir() has been superseded by FPaths::ProjectSavedDir().
+// Starting from version 4.18, FPaths::GameSavedDir() and FPaths::GameDir() have been superseded by
+// FPaths::ProjectSavedDir() and FPaths::ProjectDir().
 #define ENGINE_COMPATIBILITY_LEGACY_SAVED_DIR           BELOW_ENGINE_VERSION(4, 18)
 
 // Starting from version 4.18, we have support for dual key bindings.
@@ -28,6 +29,12 @@
 // to call debug delegates after world actors are already updated.
 #define ENGINE_COMPATIBILITY_WITH_WORLD_POST_ACTOR_TICK FROM_ENGINE_VERSION(4, 18)
 
+// Starting from version 4.20, platform file interface allows to map files into memory.
+#define ENGINE_COMPATIBILITY_WITH_MAPPED_FILES          FROM_ENGINE_VERSION(4, 20)
+
+// Starting from version 4.22, render commands are enqueued with lambdas using ENQUEUE_RENDER_COMMAND.
+#define ENGINE_COMPATIBILITY_WITH_RENDER_COMMAND_LAMBDAS FROM_ENGINE_VERSION(4, 22)
+
 // Starting from version 4.24, world actor tick event has additional world parameter.
 #define ENGINE_COMPATIBILITY_LEGACY_WORLD_ACTOR_TICK    BELOW_ENGINE_VERSION(4, 24)
 
@@ -66,7 +66,7 @@ void SImGuiCanvasControl::SetActive(bool bInActive)
 	if (bActive != bInActive)
 	{
 		bActive = bInActive;
-		bBlendingOut = !bInActive;
+		bBlendingOut = !bInActive && !bPinching;
 		if (bInActive)
 		{
 			Opacity = 1.f;
@@ -75,6 +75,39 @@ void SImGuiCanvasControl::SetActive(bool bInActive)
 	}
 }
 
+void SImGuiCanvasControl::SetPinching(bool bInPinching)
+{
+	if (bPinching != bInPinching)
+	{
+		bPinching = bInPinching;
+		bBlendingOut = !bInPinching && !bActive;
+		if (bInPinching)
+		{
+			Opacity = 1.f;
+		}
+		UpdateVisibility();
+	}
+}
+
+void SImGuiCanvasControl::Pinch(const FGeometry& MyGeometry, float ScaleRatio, const FVector2D& PreviousCenter, const FVector2D& Center)
+{
+	// If blending out, then cancel.
+	bBlendingOut = false;
+
+	const float OldCanvasScale = CanvasScale;
+	CanvasScale = FMath::Clamp(CanvasScale * ScaleRatio, GetMinScale(MyGeometry), 2.f);
+
+	// Update canvas offset to keep the point under the previous centre under the current one.
+	if (OldCanvasScale != 0.f)
+	{
+		const FSlateRenderTransform ScreenToWidget = MyGeometry.GetAccumulatedRenderTransform().Inverse();
+		const FVector2D Pivot = ScreenToWidget.TransformPoint(PreviousCenter) - CanvasOffset;
+		CanvasOffset = ScreenToWidget.TransformPoint(Center) - Pivot * CanvasScale / OldCanvasScale;
+	}
+
+	UpdateRenderTransform();
+}
+
 void SImGuiCanvasControl::Tick(const FGeometry& AllottedGeometry, const double InCurrentTime, const float InDeltaTime)
 {
 	Super::Tick(AllottedGeometry, InCurrentTime, InDeltaTime);
@@ -293,7 +326,9 @@ int32 SImGuiCanvasControl::OnPaint(const FPaintArgs& Args, const FGeometry& Allo
 
 void SImGuiCanvasControl::UpdateVisibility()
 {
-	SetVisibility(bActive ? EVisibility::Visible : bBlendingOut ? EVisibility::HitTestInvisible : EVisibility::Hidden);
+	SetVisibility(bActive ? EVisibility::Visible
+		: (bPinching || bBlendingOut) ? EVisibility::HitTestInvisible
+		: EVisibility::Hidden);
 }
 
 void SImGuiCanvasControl::Zoom(const FGeometry& MyGeometry, const float Delta, const FVector2D& MousePosition)
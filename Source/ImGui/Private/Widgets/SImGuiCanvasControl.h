@@ -33,6 +33,18 @@ public:
 
 	const FSlateRenderTransform& GetTransform() const { return Transform; }
 
+	// Pinch gesture works like the active mode, but since it is driven by the parent widget, this widget doesn't take
+	// inputs while pinching.
+	bool IsPinching() const { return bPinching; }
+	void SetPinching(bool bInPinching);
+
+	// Zoom and move canvas following a pinch gesture.
+	// @param MyGeometry - Geometry of this widget
+	// @param ScaleRatio - Ratio between the current and the previous distance between touches
+	// @param PreviousCenter - Previous centre of touches (in screen space)
+	// @param Center - Current centre of touches (in screen space)
+	void Pinch(const FGeometry& MyGeometry, float ScaleRatio, const FVector2D& PreviousCenter, const FVector2D& Center);
+
 	//----------------------------------------------------------------------------------------------------
 	// SWidget overrides
 	//----------------------------------------------------------------------------------------------------
@@ -100,6 +112,9 @@ private:
 	// process inputs anymore.
 	bool bBlendingOut = false;
 
+	// Whether pinch gesture is in progress.
+	bool bPinching = false;
+
 	// Request is set on mouse button press before drag operation is started. It remains valid until activating button
 	// is released or until drag operation is finished or until it is replaced by alternative request.
 	// Highlights are bound to requests, what means that they can also be activated before drag operation is started.
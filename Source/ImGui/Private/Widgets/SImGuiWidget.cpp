@@ -71,7 +71,7 @@ void SImGuiWidget::Construct(const FArguments& InArgs)
 	ModuleManager->OnPostImGuiUpdate().AddRaw(this, &SImGuiWidget::OnPostImGuiUpdate);
 
 	// Register debug delegate.
-	auto* ContextProxy = ModuleManager->GetContextManager().GetContextProxy(ContextIndex);
+	auto* ContextProxy = GetContextProxy();
 	checkf(ContextProxy, TEXT("Missing context during widget construction: ContextIndex = %d"), ContextIndex);
 #if IMGUI_WIDGET_DEBUG
 	ContextProxy->OnDraw().AddRaw(this, &SImGuiWidget::OnDebugDraw);
@@ -107,7 +107,7 @@ SImGuiWidget::~SImGuiWidget()
 	ReleaseInputHandler();
 
 	// Remove binding between this widget and its context proxy.
-	if (auto* ContextProxy = ModuleManager->GetContextManager().GetContextProxy(ContextIndex))
+	if (auto* ContextProxy = GetContextProxy())
 	{
 #if IMGUI_WIDGET_DEBUG
 		ContextProxy->OnDraw().RemoveAll(this);
@@ -124,6 +124,7 @@ void SImGuiWidget::Tick(const FGeometry& AllottedGeometry, const double InCurren
 
 	UpdateInputState();
 	UpdateTransparentMouseInput(AllottedGeometry);
+	UpdateMouseLatch(AllottedGeometry);
 	HandleWindowFocusLost();
 }
 
@@ -214,6 +215,8 @@ void SImGuiWidget::OnFocusLost(const FFocusEvent& FocusEvent)
 
 	InputHandler->OnKeyboardInputDisabled();
 	InputHandler->OnGamepadInputDisabled();
+
+	ResetPinchGesture();
 }
 
 void SImGuiWidget::OnMouseEnter(const FGeometry& MyGeometry, const FPointerEvent& MouseEvent)
@@ -232,26 +235,50 @@ void SImGuiWidget::OnMouseLeave(const FPointerEvent& MouseEvent)
 	IMGUI_WIDGET_LOG(VeryVerbose, TEXT("ImGui Widget %d - Mouse Leave."), ContextIndex);
 
 	InputHandler->OnMouseInputDisabled();
+
+	ResetPinchGesture();
 }
 
 FReply SImGuiWidget::OnTouchStarted(const FGeometry& MyGeometry, const FPointerEvent& TouchEvent)
 {
+	UpdatePinchGesture(MyGeometry, TouchEvent, true);
 	return InputHandler->OnTouchStarted(TransformScreenPointToImGui(MyGeometry, TouchEvent.GetScreenSpacePosition()), TouchEvent);
 }
 
 FReply SImGuiWidget::OnTouchMoved(const FGeometry& MyGeometry, const FPointerEvent& TouchEvent)
 {
+	UpdatePinchGesture(MyGeometry, TouchEvent, true);
 	return InputHandler->OnTouchMoved(TransformScreenPointToImGui(MyGeometry, TouchEvent.GetScreenSpacePosition()), TouchEvent);
 }
 
 FReply SImGuiWidget::OnTouchEnded(const FGeometry& MyGeometry, const FPointerEvent& TouchEvent)
 {
+	UpdatePinchGesture(MyGeometry, TouchEvent, false);
 	UpdateVisibility();
 	return InputHandler->OnTouchEnded(TransformScreenPointToImGui(MyGeometry, TouchEvent.GetScreenSpacePosition()), TouchEvent);
 }
 
+FImGuiContextProxy* SImGuiWidget::GetContextProxy() const
+{
+	FImGuiContextManager& ContextManager = ModuleManager->GetContextManager();
+	FImGuiContextProxy* ContextProxy = ContextManager.GetContextProxy(ContextHandle);
+	if (UNLIKELY(!ContextProxy))
+	{
+		ContextHandle = ContextManager.GetContextHandle(ContextIndex);
+		ContextProxy = ContextManager.GetContextProxy(ContextHandle);
+	}
+	return ContextProxy;
+}
+
 void SImGuiWidget::CreateInputHandler(const FStringClassReference& HandlerClassReference)
 {
+	// Keep the current handler, if it is of the requested class (e.g. after changing reference to the default class),
+	// so it doesn't lose its state.
+	if (InputHandler.IsValid() && InputHandler->GetClass() == FImGuiInputHandlerFactory::GetHandlerClass(HandlerClassReference))
+	{
+		return;
+	}
+
 	ReleaseInputHandler();
 
 	if (!InputHandler.IsValid())
@@ -273,13 +300,9 @@ void SImGuiWidget::RegisterImGuiSettingsDelegates()
 {
 	auto& Settings = ModuleManager->GetSettings();
 
-	if (!Settings.OnImGuiInputHandlerClassChanged.IsBoundToObject(this))
+	if (!Settings.OnSettingsChanged.IsBoundToObject(this))
 	{
-		Settings.OnImGuiInputHandlerClassChanged.AddRaw(this, &SImGuiWidget::CreateInputHandler);
-	}
-	if (!Settings.OnUseSoftwareCursorChanged.IsBoundToObject(this))
-	{
-		Settings.OnUseSoftwareCursorChanged.AddRaw(this, &SImGuiWidget::SetHideMouseCursor);
+		Settings.OnSettingsChanged.AddRaw(this, &SImGuiWidget::OnSettingsChanged);
 	}
 }
 
@@ -287,8 +310,21 @@ void SImGuiWidget::UnregisterImGuiSettingsDelegates()
 {
 	auto& Settings = ModuleManager->GetSettings();
 
-	Settings.OnImGuiInputHandlerClassChanged.RemoveAll(this);
-	Settings.OnUseSoftwareCursorChanged.RemoveAll(this);
+	Settings.OnSettingsChanged.RemoveAll(this);
+}
+
+void SImGuiWidget::OnSettingsChanged(EImGuiSettingsChange Changes)
+{
+	const auto& Settings = ModuleManager->GetSettings();
+
+	if (EnumHasAnyFlags(Changes, EImGuiSettingsChange::InputHandlerClass))
+	{
+		CreateInputHandler(Settings.GetImGuiInputHandlerClass());
+	}
+	if (EnumHasAnyFlags(Changes, EImGuiSettingsChange::SoftwareCursor))
+	{
+		SetHideMouseCursor(Settings.UseSoftwareCursor());
+	}
 }
 
 void SImGuiWidget::SetHideMouseCursor(bool bHide)
@@ -319,7 +355,7 @@ void SImGuiWidget::UpdateMouseCursor()
 {
 	if (!bHideMouseCursor)
 	{
-		const FImGuiContextProxy* ContextProxy = ModuleManager->GetContextManager().GetContextProxy(ContextIndex);
+		const FImGuiContextProxy* ContextProxy = GetContextProxy();
 		SetCursor(ContextProxy ? ContextProxy->GetMouseCursor() : EMouseCursor::Default);
 	}
 	else
@@ -390,7 +426,7 @@ void SImGuiWidget::ReturnFocus()
 void SImGuiWidget::UpdateInputState()
 {
 	auto& Properties = ModuleManager->GetProperties();
-	auto* ContextProxy = ModuleManager->GetContextManager().GetContextProxy(ContextIndex);
+	auto* ContextProxy = GetContextProxy();
 
 	const bool bEnableTransparentMouseInput = Properties.IsMouseInputShared()
 #if PLATFORM_ANDROID || PLATFORM_IOS
@@ -430,6 +466,7 @@ void SImGuiWidget::UpdateInputState()
 		else
 		{
 			ReturnFocus();
+			ResetPinchGesture();
 		}
 	}
 	else if(bInputEnabled)
@@ -469,6 +506,31 @@ void SImGuiWidget::UpdateTransparentMouseInput(const FGeometry& AllottedGeometry
 	}
 }
 
+void SImGuiWidget::UpdateMouseLatch(const FGeometry& AllottedGeometry)
+{
+	if (FImGuiContextProxy* ContextProxy = GetContextProxy())
+	{
+		FImGuiInputState& InputState = ContextProxy->GetInputState();
+		const auto& Settings = ModuleManager->GetSettings();
+
+		// Latch mouse only when it would be otherwise updated by mouse move events.
+		const bool bHasMouse = bTransparentMouseInput
+			? !GameViewport->GetGameViewportWidget()->HasMouseCapture()
+			: IsHovered();
+
+		if (bInputEnabled && bHasMouse && Settings.LateLatchMousePosition())
+		{
+			// Transform from screen to ImGui space is cached, so context can sample cursor when it starts a new frame.
+			const FSlateRenderTransform ImGuiToScreen = ImGuiTransform.Concatenate(AllottedGeometry.GetAccumulatedRenderTransform());
+			InputState.EnableMouseLatch(ImGuiToScreen.Inverse(), Settings.PredictMousePosition());
+		}
+		else
+		{
+			InputState.DisableMouseLatch();
+		}
+	}
+}
+
 void SImGuiWidget::HandleWindowFocusLost()
 {
 	// We can use window foreground status to notify about application losing or receiving focus. In some situations
@@ -491,6 +553,7 @@ void SImGuiWidget::HandleWindowFocusLost()
 			{
 				InputHandler->OnKeyboardInputDisabled();
 				InputHandler->OnGamepadInputDisabled();
+				ResetPinchGesture();
 			}
 		}
 	}
@@ -501,6 +564,49 @@ void SImGuiWidget::UpdateCanvasControlMode(const FInputEvent& InputEvent)
 	CanvasControlWidget->SetActive(InputEvent.IsLeftAltDown() && InputEvent.IsLeftShiftDown());
 }
 
+void SImGuiWidget::UpdatePinchGesture(const FGeometry& MyGeometry, const FPointerEvent& TouchEvent, bool bIsDown)
+{
+	const uint32 PointerIndex = TouchEvent.GetPointerIndex();
+	const FVector2D& Position = TouchEvent.GetScreenSpacePosition();
+
+	const int32 Index = PinchTouches.IndexOfByPredicate([PointerIndex](const TPair<uint32, FVector2D>& Touch) { return Touch.Key == PointerIndex; });
+	if (Index == INDEX_NONE)
+	{
+		if (bIsDown && PinchTouches.Num() < 2)
+		{
+			PinchTouches.Emplace(PointerIndex, Position);
+		}
+	}
+	else if (bIsDown)
+	{
+		if (PinchTouches.Num() == 2)
+		{
+			const FVector2D& Other = PinchTouches[1 - Index].Value;
+			const float PreviousSpan = FVector2D::Distance(PinchTouches[Index].Value, Other);
+			const float Span = FVector2D::Distance(Position, Other);
+			if (PreviousSpan > 0.f && Span > 0.f)
+			{
+				CanvasControlWidget->Pinch(MyGeometry, Span / PreviousSpan, (PinchTouches[Index].Value + Other) * 0.5f,
+					(Position + Other) * 0.5f);
+			}
+		}
+		PinchTouches[Index].Value = Position;
+	}
+	else
+	{
+		PinchTouches.RemoveAt(Index);
+	}
+
+	CanvasControlWidget->SetPinching(PinchTouches.Num() == 2);
+}
+
+void SImGuiWidget::ResetPinchGesture()
+{
+	// Touches may end without notification after losing focus, so they are dropped to not turn later drags into pinch.
+	PinchTouches.Reset();
+	CanvasControlWidget->SetPinching(false);
+}
+
 void SImGuiWidget::OnPostImGuiUpdate()
 {
 	ImGuiRenderTransform = ImGuiTransform;
@@ -526,7 +632,7 @@ namespace
 int32 SImGuiWidget::OnPaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry, const FSlateRect& MyClippingRect,
 	FSlateWindowElementList& OutDrawElements, int32 LayerId, const FWidgetStyle& WidgetStyle, bool bParentEnabled) const
 {
-	if (FImGuiContextProxy* ContextProxy = ModuleManager->GetContextManager().GetContextProxy(ContextIndex))
+	if (FImGuiContextProxy* ContextProxy = GetContextProxy())
 	{
 		// Manually update ImGui context to minimise lag between creating and rendering ImGui output. This will also
 		// keep frame tearing at minimum because it is executed at the very end of the frame.
@@ -728,7 +834,7 @@ namespace Styles
 
 void SImGuiWidget::OnDebugDraw()
 {
-	FImGuiContextProxy* ContextProxy = ModuleManager->GetContextManager().GetContextProxy(ContextIndex);
+	FImGuiContextProxy* ContextProxy = GetContextProxy();
 
 	if (CVars::DebugWidget.GetValueOnGameThread() > 0)
 	{
@@ -863,8 +969,10 @@ void SImGuiWidget::OnDebugDraw()
 			{
 				TwoColumns::Value("Position X", InputState.GetMousePosition().X);
 				TwoColumns::Value("Position Y", InputState.GetMousePosition().Y);
+				TwoColumns::Value("Velocity X", InputState.GetMouseVelocity().X);
+				TwoColumns::Value("Velocity Y", InputState.GetMouseVelocity().Y);
 				TwoColumns::Value("Wheel Delta", InputState.GetMouseWheelDelta());
-				ImGui::NextColumn(); ImGui::NextColumn();
+				TwoColumns::Value("Touches", InputState.GetTouchCount());
 			});
 
 			if (!bDebug)
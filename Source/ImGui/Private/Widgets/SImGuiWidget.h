@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include "ImGuiContextHandle.h"
 #include "ImGuiModuleDebug.h"
 #include "ImGuiModuleSettings.h"
 
@@ -11,6 +12,7 @@
 // Hide ImGui Widget debug in non-developer mode.
 #define IMGUI_WIDGET_DEBUG IMGUI_MODULE_DEVELOPER
 
+class FImGuiContextProxy;
 class FImGuiModuleManager;
 class SImGuiCanvasControl;
 class UImGuiInputHandler;
@@ -78,12 +80,17 @@ public:
 
 private:
 
+	// Get context proxy using cached handle, which is refreshed if context was recreated.
+	FImGuiContextProxy* GetContextProxy() const;
+
 	void CreateInputHandler(const FStringClassReference& HandlerClassReference);
 	void ReleaseInputHandler();
 
 	void RegisterImGuiSettingsDelegates();
 	void UnregisterImGuiSettingsDelegates();
 
+	void OnSettingsChanged(EImGuiSettingsChange Changes);
+
 	void SetHideMouseCursor(bool bHide);
 
 	bool IsConsoleOpened() const;
@@ -101,10 +108,15 @@ private:
 	// Update input state.
 	void UpdateInputState();
 	void UpdateTransparentMouseInput(const FGeometry& AllottedGeometry);
+	void UpdateMouseLatch(const FGeometry& AllottedGeometry);
 	void HandleWindowFocusLost();
 
 	void UpdateCanvasControlMode(const FInputEvent& InputEvent);
 
+	// Track touches and pass pinch gestures to canvas control.
+	void UpdatePinchGesture(const FGeometry& MyGeometry, const FPointerEvent& TouchEvent, bool bIsDown);
+	void ResetPinchGesture();
+
 	void OnPostImGuiUpdate();
 
 	FVector2D TransformScreenPointToImGui(const FGeometry& MyGeometry, const FVector2D& Point) const;
@@ -130,6 +142,7 @@ private:
 	mutable TArray<SlateIndex> IndexBuffer;
 
 	int32 ContextIndex = 0;
+	mutable FImGuiContextHandle ContextHandle;
 
 	bool bInputEnabled = false;
 	bool bForegroundWindow = false;
@@ -138,4 +151,7 @@ private:
 
 	TSharedPtr<SImGuiCanvasControl> CanvasControlWidget;
 	TWeakPtr<SWidget> PreviousUserFocusedWidget;
+
+	// The first two touches (pointer index and screen position) that are down, used to recognise pinch gestures.
+	TArray<TPair<uint32, FVector2D>, TInlineAllocator<2>> PinchTouches;
 };
@@ -5,6 +5,48 @@
 #include <Core.h>
 
 
+/** Delegate returning a version of data drawn by a listener, like a revision counter (@see FImGuiListenerOptions). */
+DECLARE_DELEGATE_RetVal(uint64, FImGuiListenerVersion);
+
+/**
+ * Options of named listeners of ImGui debug events (@see FImGuiDelegates::AddWorldDebugListener).
+ */
+struct FImGuiListenerOptions
+{
+	/**
+	 * Time budget in milliseconds for a single invocation. Listeners that on average take longer are throttled to run
+	 * every N-th frame, so their average cost per frame fits within the budget. Zero means no budget.
+	 */
+	float Budget = 0.f;
+
+	/** Listeners with higher priority are invoked first. Listeners with equal priority are invoked in order of adding. */
+	int32 Priority = 0;
+
+	/** Number of frames between invocations. One means that listener is invoked every frame. */
+	int32 Interval = 1;
+
+	/**
+	 * Listeners in the same time-slice group take turns in consecutive frames, so only one of them is invoked per frame
+	 * (per interval, if it is larger than one). None means that listener is not time-sliced.
+	 */
+	FName TimeSliceGroup;
+
+	/**
+	 * Whether to redraw the last output of the listener in frames in which it is not invoked. Retained windows don't
+	 * process input and only top-level windows are retained (without child windows, popups and tooltips). Output is
+	 * only recorded by listeners that can skip frames (with interval, time-slice group or budget), so listeners invoked
+	 * every frame don't pay for recording.
+	 */
+	bool bRetainOutput = true;
+
+	/**
+	 * Optional version of the data drawn by the listener. If bound, listener is invoked only when the version changes
+	 * or when its windows are hovered, used or focused and receive input. In other frames its last output is replayed
+	 * at almost no cost. Intended for panels with static content.
+	 */
+	FImGuiListenerVersion Version;
+};
+
 /**
  * Delegates to ImGui debug events. World delegates are called once per frame during world updates and have invocation
  * lists cleared after their worlds become invalid. Multi-context delegates are called once for every updated world.
@@ -13,6 +55,8 @@
  *
  * Order of events is defined in a way that multi-context delegates can be used to draw headers and/or footers:
  * multi-context early debug, world early debug, world debug, multi-context debug.
+ *
+ * Offscreen delegates are called only for named offscreen contexts, when they are rendered (@see FImGuiModule).
  */
 class IMGUI_API FImGuiDelegates
 {
@@ -55,6 +99,49 @@ public:
 	 * @returns Simple multicast delegate to debug events called once per frame for every world to debug
 	 */
 	static FSimpleMulticastDelegate& OnMultiContextDebug();
+
+	/**
+	 * Get a delegate to ImGui offscreen debug event for given offscreen context.
+	 * @param ContextName - Name of an offscreen context
+	 * @returns Simple multicast delegate to debug events called every time when given offscreen context is rendered
+	 */
+	static FSimpleMulticastDelegate& OnOffscreenDebug(const FName& ContextName);
+
+	/**
+	 * Add a named listener to ImGui world debug event for given world. Named listeners are invoked after delegates bound
+	 * directly to the debug event, in order of their priorities. They are timed individually and their timing can be
+	 * inspected with 'ImGui.ToggleStats' command or stats group 'ImGuiListeners'.
+	 * @param World - World for which we want to add a listener
+	 * @param Name - Name identifying the listener in stats
+	 * @param Delegate - Delegate to invoke
+	 * @param Options - Listener options like time budget, priority or update interval
+	 * @returns Handle that can be used to remove the listener (@see RemoveWorldDebugListener)
+	 */
+	static FDelegateHandle AddWorldDebugListener(UWorld* World, const FName& Name, const FSimpleDelegate& Delegate,
+		const FImGuiListenerOptions& Options = FImGuiListenerOptions());
+
+	/**
+	 * Remove a named listener from ImGui world debug event for given world.
+	 * @param World - World from which we want to remove a listener
+	 * @param Handle - Handle returned when adding the listener
+	 */
+	static void RemoveWorldDebugListener(UWorld* World, const FDelegateHandle& Handle);
+
+	/**
+	 * Add a named listener to ImGui multi-context debug event (@see AddWorldDebugListener).
+	 * @param Name - Name identifying the listener in stats
+	 * @param Delegate - Delegate to invoke
+	 * @param Options - Listener options like time budget, priority or update interval
+	 * @returns Handle that can be used to remove the listener (@see RemoveMultiContextDebugListener)
+	 */
+	static FDelegateHandle AddMultiContextDebugListener(const FName& Name, const FSimpleDelegate& Delegate,
+		const FImGuiListenerOptions& Options = FImGuiListenerOptions());
+
+	/**
+	 * Remove a named listener from ImGui multi-context debug event.
+	 * @param Handle - Handle returned when adding the listener
+	 */
+	static void RemoveMultiContextDebugListener(const FDelegateHandle& Handle);
 };
 
 
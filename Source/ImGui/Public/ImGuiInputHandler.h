@@ -12,6 +12,8 @@
 class FImGuiModuleManager;
 class UGameViewportClient;
 
+enum class EImGuiSettingsChange : uint32;
+
 struct FAnalogInputEvent;
 struct FCharacterEvent;
 struct FKeyEvent;
@@ -169,7 +171,7 @@ private:
 
 	void UpdateInputStatePointer();
 
-	void OnSoftwareCursorChanged(bool);
+	void OnSettingsChanged(EImGuiSettingsChange Changes);
 
 	void OnPostImGuiUpdate();
 
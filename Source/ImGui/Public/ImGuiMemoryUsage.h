@@ -0,0 +1,28 @@
+// Distributed under the MIT License (MIT) (see accompanying LICENSE file)
+
+#pragma once
+
+#include <CoreMinimal.h>
+
+
+/**
+ * Snapshot of memory allocated by ImGui on behalf of a single owner. Owners are ImGui contexts, identified by their
+ * names, and shared resources (like font atlas), which are reported under the name "Shared".
+ */
+struct FImGuiMemoryUsage
+{
+	/** Name of the owner. */
+	FString Name;
+
+	/** Number of bytes currently allocated by the owner. */
+	int64 LiveBytes = 0;
+
+	/** The highest number of bytes allocated by the owner at any time. */
+	int64 PeakBytes = 0;
+
+	/** Number of allocations that are not yet released. */
+	int64 LiveAllocations = 0;
+
+	/** Number of all allocations made by the owner. */
+	int64 TotalAllocations = 0;
+};
@@ -3,6 +3,7 @@
 #pragma once
 
 #include "ImGuiDelegates.h"
+#include "ImGuiMemoryUsage.h"
 #include "ImGuiModuleProperties.h"
 #include "ImGuiTextureHandle.h"
 
@@ -108,6 +109,42 @@ public:
 	 */
 	virtual void ReleaseTexture(const FImGuiTextureHandle& Handle);
 
+	/**
+	 * Update offscreen context with given name and rasterise its output on CPU. Offscreen contexts are created on demand
+	 * and they are not tied to any world or viewport. Each call advances context by one frame, during which it calls
+	 * delegates registered with FImGuiDelegates::OnOffscreenDebug. CPU rendering doesn't need GPU or Slate, so it can be
+	 * used in dedicated servers, commandlets and tests. Only font atlas is sampled, other textures are rendered as white.
+	 *
+	 * @param ContextName - Name of the offscreen context
+	 * @param Width - Width of the output in pixels
+	 * @param Height - Height of the output in pixels
+	 * @param OutPixels - Output buffer of Width x Height pixels, alpha-blended over a transparent background
+	 * @param DeltaSeconds - Time passed since the previous update
+	 */
+	virtual void RenderOffscreenContext(const FName& ContextName, int32 Width, int32 Height, TArray<FColor>& OutPixels,
+		float DeltaSeconds = 1.f / 60.f);
+
+	/**
+	 * Update offscreen context with given name and render its output to a render target (@see version rendering to
+	 * CPU buffer for details). Output is rasterised on CPU and uploaded to the render target.
+	 *
+	 * @param ContextName - Name of the offscreen context
+	 * @param RenderTarget - Render target in RGBA8 format. Its size defines display size of the context
+	 * @param DeltaSeconds - Time passed since the previous update
+	 * @returns True, if output was copied to the render target
+	 */
+	virtual bool RenderOffscreenContext(const FName& ContextName, class UTextureRenderTarget2D* RenderTarget,
+		float DeltaSeconds = 1.f / 60.f);
+
+	/**
+	 * Get memory allocated by ImGui, separately for each context and for shared resources (like font atlas). Memory
+	 * allocated by ImGui while drawing to a context (including allocations made by draw delegates) is attributed to
+	 * that context.
+	 *
+	 * @param OutUsage - Array filled with memory usage of all owners, starting with shared resources
+	 */
+	virtual void GetMemoryUsage(TArray<FImGuiMemoryUsage>& OutUsage) const;
+
 	/**
 	 * Get ImGui module properties.
 	 *
@@ -71,6 +71,15 @@ public:
 	/** Toggle ImGui demo. */
 	void ToggleDemo() { SetShowDemo(!ShowDemo()); }
 
+	/** Check whether ImGui memory and listener stats are visible. */
+	bool ShowStats() const { return bShowStats; }
+
+	/** Show or hide ImGui memory and listener stats. */
+	void SetShowStats(bool bShow) { bShowStats = bShow; }
+
+	/** Toggle ImGui memory and listener stats. */
+	void ToggleStats() { SetShowStats(!ShowStats()); }
+
 private:
 
 	bool bInputEnabled = false;
@@ -83,4 +92,5 @@ private:
 	bool bMouseInputShared = false;
 
 	bool bShowDemo = false;
+	bool bShowStats = false;
 };